@@ -0,0 +1,218 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DOUBLEDOUBLE_H
+#define DOUBLEDOUBLE_H
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+
+/**
+	@brief			Double-double: unevaluated sum hi + lo of 2 doubles, about 106 bits of mantissa
+
+	The error of each double operation is recovered exactly with two-sum and an FMA two-product,
+	so the arithmetic runs at hardware speed; the range is the one of double. The build must not
+	contract or reassociate floating-point expressions (no -ffast-math).
+*/
+
+struct DoubleDouble
+{
+    double hi, lo;
+
+    DoubleDouble() = default;
+
+    constexpr DoubleDouble(double a)
+        : hi(a), lo(0.)
+    {
+    }
+
+    constexpr DoubleDouble(double hi, double lo)
+        : hi(hi), lo(lo)
+    {
+    }
+
+    explicit operator double() const
+    {
+        return hi;
+    }
+
+    // exactly
+    explicit operator boost::multiprecision::cpp_bin_float_quad() const;
+
+    // exact sums & product of 2 doubles
+    static DoubleDouble sum(double a, double b)
+    {
+        double const s = a + b, v = s - a;
+
+        return DoubleDouble(s, (a - (s - v)) + (b - v));
+    }
+
+    static DoubleDouble quick(double a, double b)
+    {
+        double const s = a + b;
+
+        return DoubleDouble(s, b - (s - a));
+    }
+
+    static DoubleDouble product(double a, double b)
+    {
+        double const p = a * b;
+
+        return DoubleDouble(p, std::fma(a, b, - p));
+    }
+
+    DoubleDouble operator - () const
+    {
+        return DoubleDouble(- hi, - lo);
+    }
+
+    DoubleDouble & operator += (const DoubleDouble & b)
+    {
+        DoubleDouble s = sum(hi, b.hi);
+        DoubleDouble const t = sum(lo, b.lo);
+
+        s.lo += t.hi;
+        s = quick(s.hi, s.lo);
+        s.lo += t.lo;
+
+        return * this = quick(s.hi, s.lo);
+    }
+
+    DoubleDouble & operator -= (const DoubleDouble & b)
+    {
+        return * this += - b;
+    }
+
+    DoubleDouble & operator *= (const DoubleDouble & b)
+    {
+        DoubleDouble p = product(hi, b.hi);
+
+        p.lo += hi * b.lo + lo * b.hi;
+
+        return * this = quick(p.hi, p.lo);
+    }
+
+    DoubleDouble & operator /= (const DoubleDouble & b);
+};
+
+namespace std
+{
+    template <>
+        class numeric_limits<DoubleDouble> : public numeric_limits<double>
+        {
+        public:
+            static constexpr int digits = 106;
+            static constexpr int digits10 = 31;
+            static constexpr int max_digits10 = 33;
+
+            static constexpr DoubleDouble epsilon() { return DoubleDouble(0x1p-105); }
+            static constexpr DoubleDouble min() { return DoubleDouble(numeric_limits<double>::min()); }
+            static constexpr DoubleDouble max() { return DoubleDouble(numeric_limits<double>::max()); }
+            static constexpr DoubleDouble lowest() { return DoubleDouble(numeric_limits<double>::lowest()); }
+        };
+}
+
+inline DoubleDouble operator + (DoubleDouble a, const DoubleDouble & b) { return a += b; }
+inline DoubleDouble operator - (DoubleDouble a, const DoubleDouble & b) { return a -= b; }
+inline DoubleDouble operator * (DoubleDouble a, const DoubleDouble & b) { return a *= b; }
+inline DoubleDouble operator / (DoubleDouble a, const DoubleDouble & b) { return a /= b; }
+
+// long division: 2 quotient digits & a correction
+inline DoubleDouble & DoubleDouble::operator /= (const DoubleDouble & b)
+{
+    double const q1 = hi / b.hi;
+    DoubleDouble r = * this - b * q1;
+
+    double const q2 = r.hi / b.hi;
+
+    r -= b * q2;
+
+    double const q3 = r.hi / b.hi;
+
+    return * this = quick(q1, q2) + q3;
+}
+
+inline bool operator == (const DoubleDouble & a, const DoubleDouble & b) { return a.hi == b.hi && a.lo == b.lo; }
+inline bool operator != (const DoubleDouble & a, const DoubleDouble & b) { return ! (a == b); }
+inline bool operator < (const DoubleDouble & a, const DoubleDouble & b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+inline bool operator > (const DoubleDouble & a, const DoubleDouble & b) { return b < a; }
+inline bool operator <= (const DoubleDouble & a, const DoubleDouble & b) { return ! (b < a); }
+inline bool operator >= (const DoubleDouble & a, const DoubleDouble & b) { return ! (a < b); }
+
+inline bool signbit(const DoubleDouble & a)
+{
+    return std::signbit(a.hi);
+}
+
+inline DoubleDouble abs(const DoubleDouble & a)
+{
+    return signbit(a) ? - a : a;
+}
+
+inline DoubleDouble floor(const DoubleDouble & a)
+{
+    double const h = std::floor(a.hi);
+
+    // hi is an integer already: the fraction is in lo
+    return h == a.hi ? DoubleDouble::quick(h, std::floor(a.lo)) : DoubleDouble(h);
+}
+
+// half away from zero, like std::round
+inline DoubleDouble round(const DoubleDouble & a)
+{
+    return signbit(a) ? - floor(- a + .5) : floor(a + .5);
+}
+
+inline DoubleDouble sqrt(const DoubleDouble & a)
+{
+    if (a.hi <= 0.)
+        return DoubleDouble(std::sqrt(a.hi));
+
+    // one Newton step from the double root
+    double const s = std::sqrt(a.hi);
+    DoubleDouble const r = a - DoubleDouble::product(s, s);
+
+    return DoubleDouble::quick(s, r.hi / (2 * s));
+}
+
+inline DoubleDouble pow(const DoubleDouble & a, int n)
+{
+    DoubleDouble p = 1.;
+
+    for (int k = 0; k < std::abs(n); ++ k)
+        p *= a;
+
+    return n < 0 ? 1. / p : p;
+}
+
+inline DoubleDouble::operator boost::multiprecision::cpp_bin_float_quad() const
+{
+    typedef boost::multiprecision::cpp_bin_float_quad quad;
+
+    return quad(hi) + quad(lo);
+}
+
+// exact decimal expansion of hi + lo
+inline std::ostream & operator << (std::ostream & out, const DoubleDouble & a)
+{
+    return out << boost::multiprecision::cpp_bin_float_quad(a);
+}
+
+#endif
@@ -0,0 +1,26 @@
+# simulation engine shared by the GUI and the headless target (no QtWidgets dependency)
+# the vectorized kernels are picked at runtime: do not build with -march=native
+# DoubleDouble needs IEEE arithmetic as written: do not build with -ffast-math
+
+INCLUDEPATH += $$PWD
+
+# the force laws are instantiated with the vector types of the kernels, inlined into their target
+# regions: GCC notes the ABI of AVX returns all the same, and no pragma silences it
+QMAKE_CXXFLAGS += -Wno-psabi
+
+HEADERS	+= $$PWD/forcelaw.h \
+           $$PWD/simulation.h \
+           $$PWD/kernel.h \
+           $$PWD/kernel_simd.h \
+           $$PWD/tree.h \
+           $$PWD/triplebuffer.h \
+           $$PWD/pacer.h \
+           $$PWD/runcontrol.h \
+           $$PWD/pool.h \
+           $$PWD/doubledouble.h \
+           $$PWD/rotation.h
+SOURCES	+= $$PWD/simulation.cpp \
+           $$PWD/kernel.cpp \
+           $$PWD/tree.cpp \
+           $$PWD/pool.cpp \
+           $$PWD/rotation.cpp
@@ -0,0 +1,187 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FORCELAW_H
+#define FORCELAW_H
+
+#include <cmath>
+#include <tuple>
+#include <cstddef>
+
+#include "doubledouble.h"
+
+typedef double real;                        // scalar of the GUI & of the vectorized kernels
+typedef boost::multiprecision::cpp_bin_float_quad Quad;    // 113 bit mantissa, in software
+
+/**
+	@brief			Scalar arithmetic of type R with the interface of the vector types of the kernels (1 lane)
+
+	R is real, DoubleDouble or Quad: the functions of R are found by argument
+	dependent lookup, those of double in std.
+*/
+
+template <typename R>
+    struct Arithmetic
+    {
+        typedef R S;
+        typedef R T;
+        typedef bool M;
+
+        static constexpr size_t N = 1;
+
+        static T set1(R a) { return a; }
+        static T zero() { return 0.L; }
+        static T load(const R * p) { return * p; }
+        static void store(R * p, T a) { * p = a; }
+        static T add(T a, T b) { return a + b; }
+        static T sub(T a, T b) { return a - b; }
+        static T mul(T a, T b) { return a * b; }
+        static T div(T a, T b) { return a / b; }
+        static T sqrt(T a) { using std::sqrt; return sqrt(a); }
+        static T floor(T a) { using std::floor; return floor(a); }
+        static T abs(T a) { using std::abs; return abs(a); }
+        static M ge(T a, T b) { return a >= b; }
+        static M negative(T a) { using std::signbit; return signbit(a); }
+        static T select(M m, T a, T b) { return m ? a : b; }
+
+        // lane j is neither body i nor past the end
+        static M other(size_t j, size_t i, size_t n) { return j != i && j < n; }
+
+        static R reduce(T a) { return a; }
+    };
+
+typedef Arithmetic<real> Scalar;
+
+/**
+	@brief			Force laws: time dilation increment & acceleration caused by a mass (or a charge) m at a distance d
+
+	Each law is a policy written against the arithmetic interface V (Scalar or a vector type of the
+	kernels) so the kernels inline it; laws listed in Laws get a kernel for every instruction set.
+
+	cluster() is the acceleration caused from afar by bodies of a cell of the Barnes-Hut tree whose
+	masses (or charges) have the same sign, given their power sums s = {sum m, sum m^2, ...} and the
+	largest abs(m); it returns false when these moments are not enough, in which case the cell is
+	opened. time() must be linear in abs(m). derivative() is d acceleration() / d d, for the jerk of
+	the Hermite integrator.
+*/
+
+constexpr size_t moments = 6;               // power sums kept by the cells of the tree
+
+// Newton time & acceleration formulas
+struct Newton
+{
+    static constexpr char const * name = "Newton";
+    static constexpr bool dilation = false;                 // time() is always 0
+
+    template <class V>
+        static typename V::T time(const typename V::T & /* m */, const typename V::T & /* d */, const typename V::T & /* h */)
+        {
+            return V::zero();
+        }
+
+    template <class V>
+        static typename V::T acceleration(const typename V::T & G, const typename V::T & m, const typename V::T & d, const typename V::T & /* h */)
+        {
+            // G * m / (d * d)
+            return V::div(V::mul(G, m), V::mul(d, d));
+        }
+
+    template <class V>
+        static typename V::T derivative(const typename V::T & G, const typename V::T & m, const typename V::T & d, const typename V::T & /* h */)
+        {
+            // - 2 * G * m / (d * d * d)
+            return V::div(V::mul(V::set1(-2.), V::mul(G, m)), V::mul(V::mul(d, d), d));
+        }
+
+    template <typename R>
+        static bool cluster(R G, const R s[moments], R /* mmax */, R d, R /* h */, R & a)
+        {
+            a = G * s[0] / (d * d);
+
+            return true;
+        }
+};
+
+// FT time & acceleration formulas
+// observer is infinitly far away
+struct FiniteTheory
+{
+    static constexpr char const * name = "Finite Theory";
+    static constexpr bool dilation = true;
+
+    template <class V>
+        static typename V::T time(const typename V::T & m, const typename V::T & d, const typename V::T & /* h */)
+        {
+            // abs(m) / abs(d)
+            return V::div(V::abs(m), V::abs(d));
+        }
+
+    template <class V>
+        static typename V::T acceleration(const typename V::T & G, const typename V::T & m, const typename V::T & d, const typename V::T & h)
+        {
+            // (G * m * pow(h, 2)) / pow(d * h + m, 2)
+            typename V::T const t = V::add(V::mul(d, h), m);
+
+            return V::div(V::mul(V::mul(G, m), V::mul(h, h)), V::mul(t, t));
+        }
+
+    template <class V>
+        static typename V::T derivative(const typename V::T & G, const typename V::T & m, const typename V::T & d, const typename V::T & h)
+        {
+            // - 2 * G * m * pow(h, 3) / pow(d * h + m, 3)
+            typename V::T const t = V::add(V::mul(d, h), m);
+
+            return V::div(V::mul(V::mul(V::set1(-2.), V::mul(G, m)), V::mul(V::mul(h, h), h)), V::mul(V::mul(t, t), t));
+        }
+
+    template <typename R>
+        static bool cluster(R G, const R s[moments], R mmax, R d, R h, R & a)
+        {
+            // no acceleration at all
+            if (h == 0.L)
+            {
+                a = 0.L;
+
+                return true;
+            }
+
+            // sum of G m / d^2 * (1 - 2 x + 3 x^2 - ...) with x = m / (d * h), as long as x is small for every body
+            R const dh = d * h;
+
+            if (mmax > 1e-1L * dh)
+                return false;
+
+            a = 0.L;
+
+            R t = 1.L;
+
+            for (size_t k = 0; k < moments; ++ k, t *= - dh)
+                a += R(double(k + 1)) * s[k] / t;
+
+            a *= G / (d * d);
+
+            return true;
+        }
+};
+
+// registered laws: a new law is a policy above added here & to Law, in the same order
+typedef std::tuple<Newton, FiniteTheory> Laws;
+
+enum Law {NW, FT};
+
+#endif
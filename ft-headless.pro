@@ -0,0 +1,13 @@
+TEMPLATE  = app
+LANGUAGE  = C++
+CONFIG	 += thread c++17 console
+CONFIG	 -= qt app_bundle
+
+QMAKE_CXXFLAGS           += -O3
+
+TARGET    = ft-headless
+
+include(engine.pri)
+
+HEADERS	+= statistics.h
+SOURCES	+= headless.cpp
@@ -14,7 +14,7 @@ QT       += core gui widgets
 #QMAKE_RPATHDIR           += /opt/V-PlaySDK/5.6/gcc_64/lib/
 #QMAKE_LIBDIR             += /usr/lib
 #QMAKE_LFLAGS             += -static-libgcc -static-libg++
-QMAKE_CXXFLAGS           += -march=native -O3
+QMAKE_CXXFLAGS           += -O3
 
 #QMAKE_CFLAGS_RELEASE += /MT
 #QMAKE_CXXFLAGS_RELEASE += /MT
@@ -29,5 +29,11 @@ QMAKE_CXXFLAGS           += -march=native -O3
 
 TARGET    = ft
 
-HEADERS	+= main.h
-SOURCES	+= main.cpp
+include(engine.pri)
+
+HEADERS	+= main.h \
+           statistics.h \
+           raster.h \
+           trail.h
+SOURCES	+= main.cpp \
+           raster.cpp
@@ -0,0 +1,566 @@
+/**
+    Finite Theory Simulator
+    Copyright (c) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define EDITION "5.2.0"
+
+#include "simulation.h"
+#include "kernel.h"
+#include "pool.h"
+#include "rotation.h"
+#include "statistics.h"
+
+#include <ctime>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+static const char * const name[] = {"PP", "LB", "BB", "GR", "V1", "NU", "QU"};
+static const char * const integrator[] = {"euler", "leapfrog", "yoshida4", "yoshida6", "forest-ruth", "block", "hermite"};
+static const char * const scalar[] = {"double", "mixed", "dd", "quad"};
+
+static void usage(char const * argv0)
+{
+    cerr << "Finite Theory of the Universe " EDITION " (headless)" << endl;
+    cerr << "usage: " << argv0 << " <PP|LB|BB|GR|V1|NU|QU> <steps> [time interval (s)] [euler|leapfrog|yoshida4|yoshida6|forest-ruth|block|hermite]" << endl;
+    cerr << "       " << argv0 << " bench [years]" << endl;
+    cerr << "       " << argv0 << " precession [years] [time interval (s)]" << endl;
+    cerr << "       " << argv0 << " deflection [photons] [time interval (s)]" << endl;
+    cerr << "       " << argv0 << " rotation [rotation curve (kpc, km/s)]" << endl;
+    cerr << "       " << argv0 << " statistics [samples (5 at least)]" << endl;
+    cerr << "FT_REAL=double|mixed|dd|quad picks the scalar of the simulations (double by default; mixed: compensated double)" << endl;
+}
+
+// Newtonian energy of the bodies
+template <typename R>
+    static R energy(BasicBodies<R> const & b)
+    {
+        R e = 0.L;
+
+        for (size_t i = 0; i < b.size(); ++ i)
+        {
+            e += b.m[i] * (b.vx[i] * b.vx[i] + b.vy[i] * b.vy[i] + b.vz[i] * b.vz[i]) / 2;
+
+            for (size_t j = i + 1; j < b.size(); ++ j)
+                e -= G * b.m[i] * b.m[j] / (b.position(i) - b.position(j)).norm();
+        }
+
+        return e;
+    }
+
+/**
+	@brief			Runs the Newtonian solar system, the energy sampled 100 times outside of the timing
+	@param cpu		CPU time spent stepping (s)
+	@param error	Largest relative energy error
+	@param compensated	See Simulation::compensated
+	@return			Final position of Mercury
+*/
+
+template <typename R>
+    static basic_vector3<Quad> measure(Simulation::Integrator integrator, double dt, double years, double & cpu, double & error, bool compensated = false)
+    {
+        BasicSimulation<R> s(Planet::PP, 0);
+
+        s.integrator = integrator;
+        s.dt = dt;
+        s.compensated = compensated;
+
+        size_t const n = size_t(years * 365.25 * 86400 / dt);
+        R const e0 = energy(s.body());
+        clock_t spent = 0;
+
+        error = 0.;
+
+        for (size_t k = 0; k < 100; ++ k)
+        {
+            clock_t const b = clock();
+
+            for (size_t i = k * n / 100; i < (k + 1) * n / 100; ++ i)
+                s.step(s.dt);
+
+            spent += clock() - b;
+
+            using std::abs;
+
+            error = max(error, double(abs((energy(s.body()) - e0) / e0)));
+        }
+
+        cpu = double(spent) / CLOCKS_PER_SEC;
+
+        return basic_vector3<Quad>(s.body().position(1));
+    }
+
+/**
+	@brief			Accuracy per CPU time of the integrators then of the scalars: Newtonian solar system
+	@param years	Length of each run of the integrators (the scalars run 1% of it)
+*/
+
+static int bench(double years)
+{
+    struct Run
+    {
+        Simulation::Integrator integrator;
+        double dt;
+    };
+
+    // time intervals around the ones giving the same accuracy
+    static const Run run[] =
+    {
+        {Simulation::EULER, 1600}, {Simulation::EULER, 400},
+        {Simulation::LEAPFROG, 8000}, {Simulation::LEAPFROG, 2000},
+        {Simulation::YOSHIDA4, 32000}, {Simulation::YOSHIDA4, 8000},
+        {Simulation::HERMITE, 16000}, {Simulation::HERMITE, 4000},
+    };
+
+    double cpu, error;
+
+    cout << "PP (Newton), " << years << " years, " << kernel::name() << " kernel, " << Pool::shared().size() << " threads" << endl;
+    cout << setw(12) << left << "integrator" << right << setw(10) << "dt (s)" << setw(14) << "cpu (s)" << setw(14) << "max |dE/E|" << endl;
+
+    for (Run const & r : run)
+    {
+        measure<::real>(r.integrator, r.dt, years, cpu, error);
+
+        cout << setw(12) << left << integrator[r.integrator] << right << fixed;
+        cout << setw(10) << setprecision(0) << r.dt;
+        cout << setw(14) << setprecision(3) << cpu;
+        cout << setw(14) << setprecision(2) << scientific << error << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    // same steps in each scalar: the distance to the quad run is the rounding error
+    Run const r = {Simulation::YOSHIDA4, 2000};
+
+    basic_vector3<Quad> p[4];
+    double t[4], e[4];
+
+    p[3] = measure<Quad>(r.integrator, r.dt, years / 100, t[3], e[3]);
+    p[2] = measure<DoubleDouble>(r.integrator, r.dt, years / 100, t[2], e[2]);
+    p[1] = measure<::real>(r.integrator, r.dt, years / 100, t[1], e[1], true);
+    p[0] = measure<::real>(r.integrator, r.dt, years / 100, t[0], e[0]);
+
+    cout << endl << "PP (Newton), " << years / 100 << " years, " << integrator[r.integrator] << ", dt = " << size_t(r.dt) << " s" << endl;
+    cout << setw(12) << left << "scalar" << right << setw(14) << "cpu (s)" << setw(14) << "max |dE/E|" << setw(20) << "Mercury - quad (m)" << endl;
+
+    for (size_t k = 0; k < 4; ++ k)
+    {
+        cout << setw(12) << left << scalar[k] << right << fixed;
+        cout << setw(14) << setprecision(3) << t[k];
+        cout << setw(14) << setprecision(2) << scientific << e[k];
+        cout << setw(20) << setprecision(2) << double((p[k] - p[3]).norm()) << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    return 0;
+}
+
+/**
+	@brief			Perihelion precession of each planet in the Newton & FT twins of PP, from the apsides logged
+	@param years	Simulated time
+	@param dt		Time interval, or 0 for the default of PP
+*/
+
+static int precession(double years, double dt)
+{
+    Simulation simulation[] = {{Planet::PP, 0}, {Planet::PP, 1}};
+
+    for (Simulation & s : simulation)
+        if (dt > 0.)
+            s.dt = dt;
+
+    size_t const n = size_t(years * 365.25 * 86400 / simulation[0].dt);
+
+    auto const start = chrono::steady_clock::now();
+
+    Twins(simulation[0], simulation[1]).run(n);
+
+    chrono::duration<double> const elapsed = chrono::steady_clock::now() - start;
+
+    // rad/s to arcsec/century
+    double const unit = 180 / M_PI * 3600 * 100 * 365.25 * 86400;
+
+    cout << "PP, " << years << " years, " << integrator[simulation[0].integrator] << ", dt = " << simulation[0].dt << " s, " << elapsed.count() << " s" << endl;
+    cout << setw(12) << left << "planet" << right << setw(10) << "perihelia" << setw(16) << "Newton (\"/cy)" << setw(16) << "FT (\"/cy)" << setw(16) << "FT - Newton" << endl;
+
+    for (size_t i = 0; i < simulation[0].planet.size(); ++ i)
+    {
+        size_t const perihelia = simulation[0].planet[i].perihelia;
+
+        // a rate needs 2 perihelia
+        if (perihelia < 2)
+            continue;
+
+        ::real const p[] = {simulation[0].planet[i].precession() * unit, simulation[1].planet[i].precession() * unit};
+
+        cout << setw(12) << left << simulation[0].planet[i].n << right << setw(10) << perihelia << fixed << setprecision(3);
+        cout << setw(16) << p[0] << setw(16) << p[1] << setw(16) << p[1] - p[0] << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    return 0;
+}
+
+/**
+	@brief			Deflection of photons by the Sun in the Newton & FT twins of LB, over a sweep of impact parameters
+	@param photons	Photons added to each twin, their impact parameters spread over [10, 80] million km
+	@param dt		Time interval
+
+	All the photons of a twin move in the same run; they start from the place & with the velocity
+	of the photon of the scenario, shifted sideways, and run until they are as far on the other side.
+*/
+
+static int deflection(size_t photons, double dt)
+{
+    Simulation simulation[] = {{Planet::LB, 0}, {Planet::LB, 1}};
+    size_t const first = simulation[0].planet.size();
+
+    for (size_t t = 0; t < 2; ++ t)
+    {
+        Simulation & s = simulation[t];
+
+        s.dt = dt;
+        s.integrator = Simulation::YOSHIDA4;
+
+        for (size_t k = 0; k < photons; ++ k)
+        {
+            Planet p = s.planet[first - 1];
+
+            // at the middle of n equal slices: never 40 million km, where the photon of the scenario is
+            p.p[1] = - (1e10 + 7e10 * (k + .5) / photons);
+            p.law = t ? FT : NW;
+
+            s.insert(p);
+        }
+    }
+
+    Planet const & p = simulation[0].planet[first - 1];
+    ::real const mu = G * simulation[0].planet[0].m, x = p.p[0], v = p.v[0].norm();
+    size_t const n = size_t(2 * x / v / dt);
+
+    auto const start = chrono::steady_clock::now();
+
+    Twins(simulation[0], simulation[1]).run(n);
+
+    chrono::duration<double> const elapsed = chrono::steady_clock::now() - start;
+
+    // rad to arcsec
+    double const unit = 180 / M_PI * 3600;
+
+    cout << "LB, " << photons << " photons at " << v << " m/s, " << integrator[simulation[0].integrator] << ", dt = " << dt << " s, " << n << " steps, " << elapsed.count() << " s" << endl;
+    cout << setw(14) << "b (m)" << setw(16) << "Kepler (\")" << setw(16) << "Newton (\")" << setw(16) << "FT (\")" << setw(16) << "FT - Newton" << endl;
+
+    for (size_t k = 0; k < photons; ++ k)
+    {
+        Planet const & q = simulation[0].planet[first + k];
+
+        // hyperbola of the same initial state
+        ::real const e = q.v[0] * q.v[0] / 2 - mu / q.p.norm(), h = q.p.cross(q.v[0]).norm();
+        ::real const kepler = 2 * asin(1 / sqrt(1 + 2 * e * h * h / (mu * mu)));
+
+        ::real const d[] = {q.asymptotes.deflection(), simulation[1].planet[first + k].asymptotes.deflection()};
+
+        cout << setw(14) << setprecision(3) << scientific << - q.p[1] << fixed;
+        cout << setw(16) << kepler * unit << setw(16) << d[0] * unit << setw(16) << d[1] * unit << setw(16) << (d[1] - d[0]) * unit << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    return 0;
+}
+
+/**
+	@brief			Fits the bulge of the GR scenario to an observed rotation curve, with the Newton & FT laws
+	@param file		Radius (kpc) & velocity (km/s) per line
+
+	Newton only fits the mass; FT fits the mass & the fudge factor H[2].
+*/
+
+static int rotation(char const * file)
+{
+    RotationCurve curve;
+
+    if (! curve.load(file))
+    {
+        cerr << file << ": no rotation curve" << endl;
+        return 1;
+    }
+
+    // solar masses of the stars of GR
+    ::real const sun = 2e30L;
+
+    RotationCurve::Fit const lo[] = {{1e8L * sun, H[2], 0.L}, {1e8L * sun, 1e15L, 0.L}};
+    RotationCurve::Fit const hi[] = {{1e13L * sun, H[2], 0.L}, {1e13L * sun, 1e25L, 0.L}};
+    RotationCurve::Fit fit[2];
+
+    auto const start = chrono::steady_clock::now();
+
+    for (size_t l = 0; l < 2; ++ l)
+        fit[l] = curve.fit(Law(l), lo[l], hi[l]);
+
+    chrono::duration<double> const elapsed = chrono::steady_clock::now() - start;
+
+    cout << file << ", " << curve.point.size() << " points, " << elapsed.count() << " s, " << Pool::shared().size() << " threads" << endl;
+    cout << setw(16) << left << "law" << right << setw(16) << "bulge (suns)" << setw(16) << "H" << setw(16) << "rms (km/s)" << endl;
+
+    for (size_t l = 0; l < 2; ++ l)
+    {
+        cout << setw(16) << left << (l ? FiniteTheory::name : Newton::name) << right << scientific << setprecision(4);
+        cout << setw(16) << fit[l].m / sun << setw(16) << fit[l].h << fixed << setprecision(3) << setw(16) << fit[l].rms / 1e3 << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    vector<::real> v[2] = {vector<::real>(curve.point.size()), vector<::real>(curve.point.size())};
+
+    for (size_t l = 0; l < 2; ++ l)
+        curve.velocity(Law(l), fit[l].m, fit[l].h, v[l].data());
+
+    cout << endl << setw(10) << "r (kpc)" << setw(16) << "observed" << setw(16) << "Newton" << setw(16) << "FT" << endl;
+
+    // about 20 rows
+    for (size_t k = 0; k < curve.point.size(); k += max<size_t>(curve.point.size() / 20, 1))
+    {
+        cout << fixed << setprecision(2) << setw(10) << curve.point[k].r / 3.0856775814913673e19L << setprecision(3);
+        cout << setw(16) << curve.point[k].v / 1e3 << setw(16) << v[0][k] / 1e3 << setw(16) << v[1][k] / 1e3 << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    return 0;
+}
+
+/**
+	@brief			Running median & P-square quantiles of a stream against the sorted stream, as the GUI feeds them the anomaly
+	@param n		Samples: normal, with 1% of outliers 100 times wider
+	@return			1 if the median is not exact or the P-square median (the one of the MAD in the GUI) is off by
+					more than max(1%, 2 / sqrt(n)) of the ranks
+
+	The 5 markers of P-square are biased in the tails on such a stream: the other quantiles are shown,
+	not checked.
+*/
+
+static int statistics(size_t n)
+{
+    mt19937 gen(1);
+    normal_distribution<::real> normal;
+    uniform_real_distribution<> outlier(0., 1.);
+
+    double const p[] = {.1, .5, .9};
+
+    Median<::real> median;
+    Quantile<::real> quantile[] = {Quantile<::real>(p[0]), Quantile<::real>(p[1]), Quantile<::real>(p[2])};
+    vector<::real> sample;
+
+    int error = 0;
+
+    for (size_t k = 0; k < n; ++ k)
+    {
+        ::real const x = outlier(gen) < .01 ? 100 * normal(gen) : normal(gen);
+
+        median.insert(x);
+        sample.push_back(x);
+
+        for (Quantile<::real> & q : quantile)
+            q.insert(x);
+
+        // exact at each of the first samples & at the last one
+        if (k < 1000 || k + 1 == n)
+        {
+            vector<::real> sorted(sample);
+            size_t const h = (sorted.size() - 1) / 2;
+
+            nth_element(sorted.begin(), sorted.begin() + h, sorted.end());
+
+            ::real m = sorted[h];
+
+            if (sorted.size() % 2 == 0)
+                m = (m + * min_element(sorted.begin() + h + 1, sorted.end())) / 2;
+
+            if (median.median() != m)
+                error = 1;
+        }
+    }
+
+    sort(sample.begin(), sample.end());
+
+    cout << n << " samples, median " << (error ? "wrong" : "exact") << endl;
+    cout << setw(10) << "p" << setw(16) << "exact" << setw(16) << "P-square" << setw(16) << "rank" << endl;
+
+    double const tolerance = max(.01, 2 / sqrt(double(n)));
+
+    for (size_t k = 0; k < sizeof(p) / sizeof(* p); ++ k)
+    {
+        ::real const v = quantile[k].value();
+        double const rank = double(upper_bound(sample.begin(), sample.end(), v) - sample.begin()) / n;
+
+        if (p[k] == .5 && abs(rank - p[k]) > tolerance)
+            error = 1;
+
+        cout << fixed << setprecision(3) << setw(10) << p[k] << setw(16) << sample[size_t(p[k] * (n - 1))] << setw(16) << v << setw(16) << rank << endl;
+
+        cout.unsetf(ios::floatfield);
+    }
+
+    return error;
+}
+
+template <typename R>
+    static void print(BasicSimulation<R> const & s, char const * title)
+    {
+        cout << title << ": " << s.steps << " steps, " << s.time << " s" << endl;
+
+        for (size_t i = 0; i < s.planet.size(); ++ i)
+        {
+            basic_vector3<R> const p = s.body().position(i), v = s.body().velocity(i);
+
+            cout << "  " << setw(12) << left << s.planet[i].n << right;
+            cout << " p = {" << p[0] << ", " << p[1] << ", " << p[2] << "}";
+            cout << " v = {" << v[0] << ", " << v[1] << ", " << v[2] << "}" << endl;
+        }
+    }
+
+/**
+	@brief			Runs the Newton & FT twins of a scenario in the scalar R, then prints them
+	@param k		Integrator, or -1 for the default of the scenario
+	@param compensated	See Simulation::compensated
+*/
+
+template <typename R>
+    static void simulate(size_t e, size_t n, double dt, int k, bool compensated)
+    {
+        Planet::Type const eType = (Planet::Type) (e);
+
+        // Newton & FT twins, in lockstep
+        BasicSimulation<R> simulation[] = {{eType, 0}, {eType, 1}};
+
+        for (BasicSimulation<R> & s : simulation)
+        {
+            if (dt > 0.)
+                s.dt = dt;
+
+            if (k >= 0)
+                s.integrator = (Simulation::Integrator) (k);
+
+            s.compensated = compensated;
+        }
+
+        auto const start = chrono::steady_clock::now();
+
+        BasicTwins<R>(simulation[0], simulation[1]).run(n);
+
+        chrono::duration<double> const elapsed = chrono::steady_clock::now() - start;
+
+        cout.setf(ios::scientific, ios::floatfield);
+        cout << std::setprecision(numeric_limits<R>::digits10);
+
+        print(simulation[0], "Newton");
+        print(simulation[1], "Finite Theory");
+
+        cerr << name[e] << ": " << n << " steps in " << elapsed.count() << " s (" << (is_same<R, ::real>::value ? kernel::name() : "scalar") << " kernel, " << integrator[simulation[0].integrator] << ", " << Pool::shared().size() << " threads)" << endl;
+    }
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "bench") == 0)
+        return bench(argc > 2 ? strtod(argv[2], nullptr) : 1000);
+
+    if (argc > 1 && strcmp(argv[1], "precession") == 0)
+        return precession(argc > 2 ? strtod(argv[2], nullptr) : 10, argc > 3 ? strtod(argv[3], nullptr) : 0.);
+
+    if (argc > 1 && strcmp(argv[1], "deflection") == 0)
+        return deflection(argc > 2 ? strtoul(argv[2], nullptr, 10) : 8, argc > 3 ? strtod(argv[3], nullptr) : 100.);
+
+    if (argc > 1 && strcmp(argv[1], "rotation") == 0)
+        return rotation(argc > 2 ? argv[2] : "data/rc-ngc_2403.dat");
+
+    if (argc > 1 && strcmp(argv[1], "statistics") == 0)
+    {
+        size_t const n = argc > 2 ? strtoul(argv[2], nullptr, 10) : 100000;
+
+        // P-square has its 5 markers
+        if (n < 5)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+
+        return statistics(n);
+    }
+
+    if (argc < 3)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    size_t e = 0;
+
+    while (e < sizeof(name) / sizeof(* name) && strcmp(argv[1], name[e]) != 0)
+        ++ e;
+
+    if (e == sizeof(name) / sizeof(* name))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    size_t const n = strtoull(argv[2], nullptr, 10);
+    double const dt = argc > 3 ? strtod(argv[3], nullptr) : 0.;
+    int k = -1;
+
+    if (argc > 4)
+    {
+        k = 0;
+
+        while (k < int(sizeof(integrator) / sizeof(* integrator)) && strcmp(argv[4], integrator[k]) != 0)
+            ++ k;
+
+        if (k == int(sizeof(integrator) / sizeof(* integrator)))
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    char const * const r = getenv("FT_REAL");
+
+    if (! r || strcmp(r, scalar[0]) == 0)
+        simulate<::real>(e, n, dt, k, false);
+    else if (strcmp(r, scalar[1]) == 0)
+        simulate<::real>(e, n, dt, k, true);
+    else if (strcmp(r, scalar[2]) == 0)
+        simulate<DoubleDouble>(e, n, dt, k, false);
+    else if (strcmp(r, scalar[3]) == 0)
+        simulate<Quad>(e, n, dt, k, false);
+    else
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kernel.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KERNEL_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace kernel
+{
+
+namespace scalar_
+{
+#include "kernel_simd.h"
+}
+
+#ifdef KERNEL_X86
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+namespace avx2_
+{
+    struct V
+    {
+        typedef double S;
+        typedef __m256d T;
+        typedef __m256d M;
+
+        static constexpr size_t N = 4;
+
+        static T set1(double a) { return _mm256_set1_pd(a); }
+        static T zero() { return _mm256_setzero_pd(); }
+        static T load(const double * p) { return _mm256_loadu_pd(p); }
+        static void store(double * p, T a) { _mm256_storeu_pd(p, a); }
+        static T add(T a, T b) { return _mm256_add_pd(a, b); }
+        static T sub(T a, T b) { return _mm256_sub_pd(a, b); }
+        static T mul(T a, T b) { return _mm256_mul_pd(a, b); }
+        static T div(T a, T b) { return _mm256_div_pd(a, b); }
+        static T sqrt(T a) { return _mm256_sqrt_pd(a); }
+        static T floor(T a) { return _mm256_floor_pd(a); }
+        static T abs(T a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.), a); }
+        static M ge(T a, T b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+        static M negative(T a) { return a; } // blendv only looks at the sign bit
+        static T select(M m, T a, T b) { return _mm256_blendv_pd(b, a, m); }
+
+        // lanes j.. that are neither body i nor past the end
+        static M other(size_t j, size_t i, size_t n)
+        {
+            __m256i const l = _mm256_add_epi64(_mm256_set1_epi64x(j), _mm256_setr_epi64x(0, 1, 2, 3));
+            __m256i const self = _mm256_cmpeq_epi64(l, _mm256_set1_epi64x(i));
+            __m256i const end = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n), l);
+
+            return _mm256_castsi256_pd(_mm256_andnot_si256(self, end));
+        }
+
+        static double reduce(T a)
+        {
+            __m128d const s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+
+            return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+        }
+    };
+
+#include "kernel_simd.h"
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+namespace avx512_
+{
+    struct V
+    {
+        typedef double S;
+        typedef __m512d T;
+        typedef __mmask8 M;
+
+        static constexpr size_t N = 8;
+
+        static T set1(double a) { return _mm512_set1_pd(a); }
+        static T zero() { return _mm512_setzero_pd(); }
+        static T load(const double * p) { return _mm512_loadu_pd(p); }
+        static void store(double * p, T a) { _mm512_storeu_pd(p, a); }
+        static T add(T a, T b) { return _mm512_add_pd(a, b); }
+        static T sub(T a, T b) { return _mm512_sub_pd(a, b); }
+        static T mul(T a, T b) { return _mm512_mul_pd(a, b); }
+        static T div(T a, T b) { return _mm512_div_pd(a, b); }
+        // the masked forms, all lanes set: the unmasked ones of GCC 12 pass an uninitialized source (-Wuninitialized)
+        static T sqrt(T a) { return _mm512_mask_sqrt_pd(a, M(0xff), a); }
+        static T floor(T a) { return _mm512_mask_roundscale_pd(a, M(0xff), a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        static T abs(T a) { return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7fffffffffffffffLL))); }
+        static M ge(T a, T b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+        static M negative(T a) { return _mm512_cmplt_epi64_mask(_mm512_castpd_si512(a), _mm512_setzero_si512()); }
+        static T select(M m, T a, T b) { return _mm512_mask_blend_pd(m, b, a); }
+
+        // lanes j.. that are neither body i nor past the end
+        static M other(size_t j, size_t i, size_t n)
+        {
+            M const end = j + N <= n ? M(0xff) : M((1u << (n - j)) - 1);
+
+            return i >= j && i < j + N ? M(end & ~(1u << (i - j))) : end;
+        }
+
+        // halves then as avx2_::V: _mm512_reduce_add_pd & _mm512_castpd512_pd256 go through the unmasked extract
+        static double reduce(T a)
+        {
+            __m256d const h = _mm256_add_pd(_mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), M(0xff), a, 0), _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), M(0xff), a, 1));
+            __m128d const s = _mm_add_pd(_mm256_castpd256_pd128(h), _mm256_extractf128_pd(h, 1));
+
+            return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+        }
+    };
+
+#include "kernel_simd.h"
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+enum Isa {SCALAR, AVX2, AVX512};
+
+static char const * const isa_name[] = {"scalar", "avx2", "avx512"};
+
+// fastest instruction set of this CPU
+static Isa detect()
+{
+    char const * const e = getenv("FT_KERNEL");
+
+    if (e && strcmp(e, "scalar") == 0)
+        return SCALAR;
+
+#ifdef KERNEL_X86
+    __builtin_cpu_init();
+
+    bool const has_avx512 = __builtin_cpu_supports("avx512f");
+    bool const has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+    if (has_avx512 && ! (e && strcmp(e, "avx2") == 0))
+        return AVX512;
+
+    if (has_avx2)
+        return AVX2;
+#endif
+
+    return SCALAR;
+}
+
+static Isa isa()
+{
+    static Isa const i = detect();
+
+    return i;
+}
+
+/**
+	@brief			Returns the inlined kernel of a force law for the fastest instruction set of this CPU
+	@param law		Force law
+	@param jerk		Whether the kernel sums the jerk as well
+	@param compensated	Whether the kernel adds the rounding errors of the positions & compensates its sums
+*/
+
+template <>
+    Function<::real> select(Law law, bool jerk, bool compensated)
+    {
+        auto const laws = std::make_index_sequence<std::tuple_size<Laws>::value>();
+
+        switch (isa())
+        {
+#ifdef KERNEL_X86
+        case AVX512: return avx512_::function<avx512_::V>(law, jerk, compensated, laws);
+        case AVX2: return avx2_::function<avx2_::V>(law, jerk, compensated, laws);
+#endif
+        default: return scalar_::function<Scalar>(law, jerk, compensated, laws);
+        }
+    }
+
+template <>
+    Function<DoubleDouble> select(Law law, bool jerk, bool compensated)
+    {
+        return scalar_::function<Arithmetic<DoubleDouble>>(law, jerk, compensated, std::make_index_sequence<std::tuple_size<Laws>::value>());
+    }
+
+template <>
+    Function<Quad> select(Law law, bool jerk, bool compensated)
+    {
+        return scalar_::function<Arithmetic<Quad>>(law, jerk, compensated, std::make_index_sequence<std::tuple_size<Laws>::value>());
+    }
+
+char const * name()
+{
+    return isa_name[isa()];
+}
+
+}
@@ -0,0 +1,51 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include "simulation.h"
+
+/**
+	@brief			Pairwise force kernels: what the bodies [b, e) other than i do to body i
+
+	Every law of Laws is instantiated with its formulas inlined for the scalar, AVX2 (4 source
+	bodies at once) and AVX-512 (8 at once) instruction sets; the fastest one the CPU runs is
+	picked at runtime (FT_KERNEL=scalar|avx2|avx512 overrides the choice). Each one comes with and
+	without the jerk, which the Hermite integrator needs, and plain or compensated (see
+	Simulation::compensated). The extended scalars of the simulations only have the scalar kernel.
+*/
+
+namespace kernel
+{
+    template <typename R>
+        struct Sum
+        {
+            R a[3];                         // net acceleration
+            R tg, te;                       // gravitational & electric time dilation increments
+            R j[3];                         // jerk: time derivative of a (kernels selected with jerk only)
+        };
+
+    // vectorized kernels for real, the scalar one for DoubleDouble & Quad
+    template <typename R>
+        Function<R> select(Law law, bool jerk = false, bool compensated = false);
+
+    char const * name();
+}
+
+#endif
@@ -0,0 +1,241 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// no include guard: kernel.cpp includes this once per instruction set, in its own namespace; V is
+// the arithmetic type (scalar S, lanes N, value T, mask M)
+
+// s + c += x, Neumaier: c collects the rounding error of each addition, whichever of s & x is larger
+template <class V>
+    static void accumulate(typename V::T & s, typename V::T & c, const typename V::T & x)
+    {
+        typename V::T const t = V::add(s, x);
+
+        c = V::add(c, V::select(V::ge(V::abs(s), V::abs(x)), V::add(V::sub(s, t), x), V::add(V::sub(x, t), s)));
+        s = t;
+    }
+
+// sum of the lanes of s & c, compensated as well
+template <class V>
+    static typename V::S total(const typename V::T & s, const typename V::T & c)
+    {
+        typedef typename V::S S;
+
+        alignas(64) S l[2 * V::N];
+
+        V::store(l, s);
+        V::store(l + V::N, c);
+
+        S sum = 0.L, lost = 0.L;
+
+        for (size_t k = 0; k < 2 * V::N; ++ k)
+            accumulate<Arithmetic<S>>(sum, lost, l[k]);
+
+        return sum + lost;
+    }
+
+/**
+	@brief			Pairwise loop of the force law L over the source bodies [b, e), N at a time
+
+	With J, also sums the jerk from the relative velocities, the quantized distance following the
+	distance; the rate of the velocity of body i in the magnetic terms is left out.
+
+	With C, the positions are the ones of the bodies plus their rounding errors (Bodies::ex...)
+	and every sum is compensated, so the small terms are not lost next to the largest one.
+*/
+
+template <class V, class L, bool J, bool C>
+    static Sum<typename V::S> force(const BasicBodies<typename V::S> & body, size_t i, size_t b, size_t e, typename V::S hg, typename V::S he)
+    {
+        typedef typename V::S S;
+        typedef typename V::T T;
+        typedef typename V::M M;
+
+        T const xi = V::set1(body.x[i]), yi = V::set1(body.y[i]), zi = V::set1(body.z[i]);
+        T const ei[] = {V::set1(C ? body.ex[i] : S(0.)), V::set1(C ? body.ey[i] : S(0.)), V::set1(C ? body.ez[i] : S(0.))};
+        T const qi = V::set1(body.q[i]);
+        T const v[] = {V::set1(body.vx[i]), V::set1(body.vy[i]), V::set1(body.vz[i])};
+
+        T const Gv = V::set1(G), Kv = V::set1(K), KG = V::set1(sqrt(K/G)), c2 = V::set1(::c * ::c);
+        T const r = V::set1(1e-15), half = V::set1(0.5), one = V::set1(1.), zero = V::zero();
+        T const hgv = V::set1(hg), hev = V::set1(he);
+
+        T netacceleration[] = {zero, zero, zero};
+        T jerk[] = {zero, zero, zero};
+        T tg = zero, te = zero;
+
+        // rounding errors of the sums above (C only)
+        T lost[8] = {zero, zero, zero, zero, zero, zero, zero, zero};
+
+        auto const add = [&](T & s, T & c, const T & x)
+        {
+            if (C)
+                accumulate<V>(s, c, x);
+            else
+                s = V::add(s, x);
+        };
+
+        // the lane of body i and the lanes past the end are masked out
+        auto const pairs = [&](const S * x, const S * y, const S * z, const S * ex, const S * ey, const S * ez, const S * vx, const S * vy, const S * vz, const S * m, const S * q, const M & valid)
+        {
+            // vector and norm between the moving entity and the other ones
+            T normal[] = {V::sub(xi, V::load(x)), V::sub(yi, V::load(y)), V::sub(zi, V::load(z))};
+            T const mj = V::load(m), qj = V::load(q);
+
+            if (C)
+            {
+                normal[0] = V::add(normal[0], V::sub(ei[0], V::load(ex)));
+                normal[1] = V::add(normal[1], V::sub(ei[1], V::load(ey)));
+                normal[2] = V::add(normal[2], V::sub(ei[2], V::load(ez)));
+            }
+
+            T const norm = V::sqrt(V::add(V::add(V::mul(normal[0], normal[0]), V::mul(normal[1], normal[1])), V::mul(normal[2], normal[2])));
+
+            // quantized energy level: round() of a positive number, half away from zero
+            T const s = V::sqrt(V::div(norm, r));
+            T const f = V::floor(s);
+            T const l = V::add(f, V::select(V::ge(V::sub(s, f), half), one, zero));
+            T const dnorm = V::mul(V::mul(r, l), l);
+
+            // calculate gravitational and electric accelerations
+            T const ag = L::template acceleration<V>(Gv, mj, dnorm, hgv);
+            T const ae = V::div(L::template acceleration<V>(Kv, qj, dnorm, hev), KG);
+            T const fg = V::abs(ag);
+            T const fe = V::abs(ae);
+
+            // electric
+            T const sign = V::select(V::negative(V::mul(qi, qj)), one, V::set1(-1.));
+
+            for (size_t k = 0; k < 3; ++ k)
+            {
+                T const u = V::div(normal[k], dnorm);
+                T const w = V::div(V::mul(V::div(v[k], c2), normal[k]), dnorm);
+
+                // electric, magnetic, gravitoelectric & gravitomagnetic
+                T d = V::mul(V::mul(fe, u), sign);
+                d = V::add(d, V::mul(fe, w));
+                d = V::add(d, V::mul(fg, u));
+                d = V::add(d, V::mul(fg, w));
+
+                add(netacceleration[k], lost[k], V::sub(zero, V::select(valid, d, zero)));
+            }
+
+            if (J)
+            {
+                // relative velocity & rate of the distance
+                T const dv[] = {V::sub(v[0], V::load(vx)), V::sub(v[1], V::load(vy)), V::sub(v[2], V::load(vz))};
+                T const rate = V::div(V::add(V::add(V::mul(normal[0], dv[0]), V::mul(normal[1], dv[1])), V::mul(normal[2], dv[2])), norm);
+
+                // rates of the magnitudes
+                T const dg = V::mul(L::template derivative<V>(Gv, mj, dnorm, hgv), rate);
+                T const de = V::div(V::mul(L::template derivative<V>(Kv, qj, dnorm, hev), rate), KG);
+                T const dfg = V::select(V::negative(ag), V::sub(zero, dg), dg);
+                T const dfe = V::select(V::negative(ae), V::sub(zero, de), de);
+
+                for (size_t k = 0; k < 3; ++ k)
+                {
+                    T const u = V::div(normal[k], dnorm);
+                    T const w = V::div(V::mul(V::div(v[k], c2), normal[k]), dnorm);
+
+                    // rate of normal / dnorm
+                    T const du = V::div(V::sub(dv[k], V::mul(u, rate)), dnorm);
+                    T const dw = V::mul(V::div(v[k], c2), du);
+
+                    T d = V::mul(V::add(V::mul(dfe, sign), dfg), u);
+                    d = V::add(d, V::mul(V::add(V::mul(fe, sign), fg), du));
+                    d = V::add(d, V::mul(V::add(dfe, dfg), w));
+                    d = V::add(d, V::mul(V::add(fe, fg), dw));
+
+                    add(jerk[k], lost[3 + k], V::sub(zero, V::select(valid, d, zero)));
+                }
+            }
+
+            // calculate gravitational and electric time dilation increments
+            if (L::dilation)
+            {
+                add(tg, lost[6], V::select(valid, L::template time<V>(mj, dnorm, hgv), zero));
+                add(te, lost[7], V::select(valid, L::template time<V>(qj, dnorm, hev), zero));
+            }
+        };
+
+        size_t j = b;
+
+        for (; j + V::N <= e; j += V::N)
+            pairs(& body.x[j], & body.y[j], & body.z[j], C ? & body.ex[j] : nullptr, C ? & body.ey[j] : nullptr, C ? & body.ez[j] : nullptr, & body.vx[j], & body.vy[j], & body.vz[j], & body.m[j], & body.q[j], V::other(j, i, e));
+
+        // remainder, padded with copies of body i
+        if (j < e)
+        {
+            alignas(64) S x[V::N], y[V::N], z[V::N], ex[V::N], ey[V::N], ez[V::N], vx[V::N], vy[V::N], vz[V::N], m[V::N], q[V::N];
+
+            for (size_t k = 0; k < V::N; ++ k)
+            {
+                size_t const l = j + k < e ? j + k : i;
+
+                x[k] = body.x[l];
+                y[k] = body.y[l];
+                z[k] = body.z[l];
+                ex[k] = C ? body.ex[l] : S(0.);
+                ey[k] = C ? body.ey[l] : S(0.);
+                ez[k] = C ? body.ez[l] : S(0.);
+                vx[k] = body.vx[l];
+                vy[k] = body.vy[l];
+                vz[k] = body.vz[l];
+                m[k] = body.m[l];
+                q[k] = body.q[l];
+            }
+
+            pairs(x, y, z, ex, ey, ez, vx, vy, vz, m, q, V::other(j, i, e));
+        }
+
+        auto const reduce = [&](const T & s, const T & c)
+        {
+            return C ? total<V>(s, c) : V::reduce(s);
+        };
+
+        Sum<S> sum;
+
+        for (size_t k = 0; k < 3; ++ k)
+        {
+            sum.a[k] = reduce(netacceleration[k], lost[k]);
+            sum.j[k] = J ? reduce(jerk[k], lost[3 + k]) : 0.L;
+        }
+
+        sum.tg = reduce(tg, lost[6]);
+        sum.te = reduce(te, lost[7]);
+
+        return sum;
+    }
+
+// kernel of each registered law, without & with the jerk, plain & compensated
+template <class V, size_t... I>
+    static Function<typename V::S> function(Law law, bool jerk, bool compensated, std::index_sequence<I...>)
+    {
+        static Function<typename V::S> const table[][2][sizeof...(I)] =
+        {
+            {
+                {& force<V, typename std::tuple_element<I, Laws>::type, false, false>...},
+                {& force<V, typename std::tuple_element<I, Laws>::type, true, false>...}
+            },
+            {
+                {& force<V, typename std::tuple_element<I, Laws>::type, false, true>...},
+                {& force<V, typename std::tuple_element<I, Laws>::type, true, true>...}
+            }
+        };
+
+        return table[compensated][jerk][law];
+    }
@@ -65,6 +65,7 @@
 #include <QPaintEvent>
 #include <QVector>
 #include <QtGui/QPainter>
+#include <QElapsedTimer>
 //#include <QtWidgets/QDesktopWidget>
 #include <QtCore/QProcess>
 #include <QDebug>
@@ -73,249 +74,28 @@ using namespace std;
 
 const ::real upper = 0.1L;
 
-// FT time formula
-// observer is infinitly far away
-::real Planet::FT_Time(::real m, ::real d, ::real h)
-{
-    return abs(m) / abs(d);
-}
-
-::real Planet::FT_Acceleration(::real G, ::real m, ::real d, ::real h)
-{
-    return (G * m * pow(h, 2)) / pow(d * h + m, 2);
-}
-
-// Newton time formula
-::real Planet::NW_Time(::real m, ::real d, ::real h)
-{
-    return 0;
-}
+// display rates offered (Hz)
+static const unsigned rate[] = {10, 30, 60};
 
-::real Planet::NW_Acceleration(::real G, ::real m, ::real d, ::real h)
-{
-    return G * m / (d * d);
-}
-
-
-void bitBlt( QPaintDevice * dst, int x, int y, const QPixmap* src, int sx, int sy, int sw, int sh )
-{
-    QPainter p( dst );
-    p.drawPixmap( x, y, *src, sx, sy, sw, sh );
-}
-
-
-/** 
-	@brief			Calculates the next position of the planet or photon
-	@param planet	Planets that will affect the movement of the planet that is moving (this)
-	@param upper	Time interval
-*/
-
-inline void Planet::operator () (const vector<Planet> &planet, const ::real & dt)
-{
-    // net acceleration vector (with all planets)
-    netacceleration = vector3(0.L, 0.L, 0.L);
-
-    switch (eType)
-    {
-    default:
-        // same effect:
-#if 1
-        tg[0] = 0;
-        te[0] = 0;
-#endif
-
-        // iterate through all planets
-        for (size_t i = 0; i < planet.size(); i ++)
-        {
-            // if same entity then skip
-            if (planet[i].id == id)
-                continue;
-
-            // vector and norm between the moving entity and the other one
-            vector3 const normal((p[0] - planet[i].p[0]), (p[1] - planet[i].p[1]), (p[2] - planet[i].p[2]));
-
-            ::real const norm = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]); // distance
-            ::real const n = round(sqrt(norm/1e-15)); // quantized energy level
-            ::real const dnorm = 1e-15 * n * n; // discrete distance
-
-            // calculate gravitational and electric accelerations
-            ::real const fg = acceleration(G, planet[i].m, dnorm, hg);
-            ::real const fe = acceleration(K, planet[i].q, dnorm, he) / sqrt(K/G);
-
-            // electric
-            ::real const sign = signbit(q * planet[i].q) ? 1L : -1L;
-
-            netacceleration[0] -= abs(fe) * normal[0] / dnorm * sign;
-            netacceleration[1] -= abs(fe) * normal[1] / dnorm * sign;
-            netacceleration[2] -= abs(fe) * normal[2] / dnorm * sign;
-
-#if 1
-            // magnetic
-            netacceleration[0] -= abs(fe) * v[0][0] / (::c * ::c) * normal[0] / dnorm;
-            netacceleration[1] -= abs(fe) * v[0][1] / (::c * ::c) * normal[1] / dnorm;
-            netacceleration[2] -= abs(fe) * v[0][2] / (::c * ::c) * normal[2] / dnorm;
-#endif
-
-            // gravitoelectric
-            netacceleration[0] -= abs(fg) * normal[0] / dnorm;
-            netacceleration[1] -= abs(fg) * normal[1] / dnorm;
-            netacceleration[2] -= abs(fg) * normal[2] / dnorm;
-
-#if 1
-            // gravitomagnetic
-            netacceleration[0] -= abs(fg) * v[0][0] / (::c * ::c) * normal[0] / dnorm;
-            netacceleration[1] -= abs(fg) * v[0][1] / (::c * ::c) * normal[1] / dnorm;
-            netacceleration[2] -= abs(fg) * v[0][2] / (::c * ::c) * normal[2] / dnorm;
-#endif
-
-#if 1
-            // calculate gravitational and electric time dilation increments
-            tg[0] += time(planet[i].m, dnorm, hg);
-            te[0] += time(planet[i].q, dnorm, he);
-#endif
-        }
-        break;
-    }
-
-#if 0
-    // spherical coordinates
-    if (! first)
-    {
-        ps[2] = ps[1];
-        ps[1] = ps[0];
-    }
-
-    ps[0][0] = sqrt(pow(p[0], 2) + pow(p[1], 2) + pow(p[2], 2));
-    ps[0][1] = atan2(p[1], p[0]);
-    ps[0][2] = acos(p[2] / ps[0][0]);
-
-    if (first)
-    {
-        ps[2] = ps[0];
-        ps[1] = ps[0];
-    }
-#endif
-
-    // save
-    const vector3 s(p[0], p[1], p[2]);
-
-    {
-#if 0
-        // calculate net gravitational and electric time dilation factors
-        tg[0] = hg / (tg[0] + hg);
-        te[0] = he / (te[0] + he);
-
-        // save old time value
-        if (! first)
-        {
-            tg[1] = tg[0];
-            te[1] = te[0];
-        }
-
-        if (first)
-        {
-            tg[1] = tg[0];
-            te[1] = te[0];
-        }
-
-        const ::real ddt = dt * tg[0] * te[0];
-#endif
-
-        // v = v + a*t
-        v[0] += netacceleration * dt;
-
-        // p = p + v*t + (a*t^2)/2
-        p += v[0] * dt + netacceleration * dt * dt / 2;
-    }
-
-#if 0
-    {
-        static mutex x;
-        scoped_lock l(x);
-
-        cout << n << ": {" << p[0] << ", " << p[1] << ", " << p[2] << "}, " << "{" << v[0][0] << ", " << v[0][1] << ", " << v[0][2] << "}" << endl;
-    }
-#endif
-
-    switch (eType)
-	{
-    // perihelion precession
-    case PP:
-        if (first || ps[1][0] < ps[2][0] && ps[1][0] < ps[0][0])
-        {
-            if (! first)
-            {
-                ps[4] = ps[3];
-            }
-
-            ps[3] = ps[1];
-
-            if (first)
-            {
-                ps[4] = ps[3];
-            }
-            else
-            {
-                updated = true;
-            }
-        }
-        break;
-
-	// gravitational light bending
-	case LB:
-        if (s[0] >= -200000000000.L && p[0] < -200000000000.L)
-		{
-			pp[1] = pp[0];
-			
-            updated = true;
-		}
-		break;
-
-    // big bang & pioneer 10
-    case BB:
-    case V1:
-        if (floor(s[0] / 1e10) != floor(p[0] / 1e10))
-        {
-            v[1] = v[0];
-
-            updated = true;
-        }
-        break;
-
-    case NU:
-    case QU:
-        updated = true;
-
-        break;
-    }
-
-    first = false;
-}
-
-Dual::Dual(Canvas * pParent) : p(pParent)
+Dual::Dual(DualCanvas * pParent) : p(pParent)
 {
     start();
 }
 
 void Dual::run()
 {
-	Scribble * q = static_cast<Scribble *>(p->topLevelWidget());
-	
-    while (true)
-	{
-		// stop the processing until the tab becomes visible
-		while (! p->isVisible())
-			QThread::msleep(100);
-		
-		// move the same planet or photon according to Newton & FT
-        {
-          vector<Planet> temporary = p->planet;
+    Twins twins(p->left->simulation, p->right->simulation);
 
-          for (size_t i = 0; i < p->planet.size(); ++ i)
-            temporary[i](p->planet, q->pTime->value());
+    // blocked while paused, until stopped
+    while (p->control.proceed())
+	{
+		// held to the real-time factor, if any, while running; single steps go at once, and a pause or
+		// a stop during the wait skips the step
+        if (p->control.running() && ! p->pacer.pace(p->left->simulation.time, [this] { return p->control.running(); }))
+            continue;
 
-          p->planet = temporary;
-        }
+		// move the same planet or photon according to Newton & FT, in lockstep
+        twins.step(p->left->simulation.dt);
 	}
 }
 
@@ -323,7 +103,7 @@ const bool no_writing = false;
 
 Canvas::Canvas( Type eType, size_t t, QWidget *parent)
     : QWidget( parent/*, name, Qt::WStaticContents*/ ),
-      eType(eType), t(t), pen( Qt::red, 3 ), polyline(3), mousePressed( false ), buffer( width(), height() )
+      eType(eType), t(t), pen( Qt::red, 3 ), polyline(3), mousePressed( false ), simulation((Planet::Type) eType, t)
 {
 //	setAttribute(Qt::WA_PaintOutsidePaintEvent, true);
 
@@ -340,865 +120,42 @@ Canvas::Canvas( Type eType, size_t t, QWidget *parent)
     }
 #endif
 
-	Scribble * q = static_cast<Scribble *>(topLevelWidget());
-	
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dist(0.0, 1.0);
-
-	// initial position of each planet and photon
-    static const ::real pos[2][75][3] =
-	{
-        // newton
-        {
-            {0.L, 0.L, 0.L},
-            //{-57025548112.2453L, 3197006916.08582L, 5283916036.50742L},
-            //{-57358990223.0187831L, 0.L, 0.L},
-            {-45922743041.70308L, 0.L, 0.L},
-            {26317771130.7392L, 105373484164.43L, 481049442.321637L},
-            {-40584904469.4072L, -146162841483.741L, 582517208.913105L},
-            {192608888576.284L, -72078449728.0548L, -5537406864.12226L},
-            {-230068941192.889L, -766153804794.071L, 9039825087.87588L},
-            {1359034179077.08L, -555461097003.149L, -48376702948.4567L},
-            {1905563957085.85L, 2247912953966.77L, -16532490448.7952L},
-            {1788083649521.39L, 4079380837677.57L, -125881827325.591L},
-            {-4043923627184.17L, 3575690969311.01L, 795204553555.504L},
-
-            {250000000000.L, -40000000000.L, 0.L},
-            {250000000000.L, -40000000000.L, 0.L},
-
-            {-50000000000.L, 50000000000.L, 0.L},
-            {0.L, 50000000000.L, 0.L},
-            {50000000000.L, 50000000000.L, 0.L},
-            {-50000000000.L, 0.L, 0.L},
-            {50000000000.L, 0.L, 0.L},
-            {-50000000000.L, -50000000000.L, 0.L},
-            {0.L, -50000000000.L, 0.L},
-            {50000000000.L, -50000000000.L, 0.L},
-
-            // galaxy:
-            {-2.46e20L * 4/4, 0.L, 0.L},
-            {-2.46e20L * 3/4, 0.L, 0.L},
-            {-2.46e20L * 2/4, 0.L, 0.L},
-            {-2.46e20L * 1/4, 0.L, 0.L},
-            {2.46e20L * 1/4, 0.L, 0.L},
-            {2.46e20L * 2/4, 0.L, 0.L},
-            {2.46e20L * 3/4, 0.L, 0.L},
-            {2.46e20L * 4/4, 0.L, 0.L},
-
-            {17048116800000.L, 0.L, 0.L},
-            {17048116800000.L, 0.L, 0.L},
-
-            // quarks positions:
-            {5.41035e-11 + 4.49183e-10, -1.18697e-10 + -9.91138e-10, 0},
-            {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
-            {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
-
-            {5.41035e-11 + -5.37561e-11, -1.18697e-10 + 1.09574e-10, 0},
-            {5.41035e-11 + -4.85478e-11, -1.18697e-10 + 1.20417e-10, 0},
-            {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
-
-            {0.5e-15L, -0.5e-15L, 0.L},
-            {0e-15L, -0e-15L, 0.L},
-            {-0.5e-15L, 0.5e-15L, 0.L},
-
-            // protons, neutrons and electrons:
-            {1e-15L, 0.L, 0.L},
-            {-1e-15L, 0.L, 0.L},
-            {0.L, 1e-15L, 0.L},
-            {0.L, -1e-15L, 0.L},
-            {0.L, 0.L, 1e-15L},
-            {0.L, 0.L, -1e-15L},
-            {1e-15L, 1e-15L, 0.L},
-            {-1e-15L, 1e-15L, 0.L},
-            {0.L, 1e-15L, 1e-15L},
-            {0.L, -1e-15L, 1e-15L},
-            {1e-15L, 0.L, 1e-15L},
-            {1e-15L, 0.L, -1e-15L},
-            {a * 1 * 1, 0.L, 0.L},
-            {-a * 1 * 1, 0.L, 0.L},
-            {0.L, a * 2 * 2, 0.L},
-            {0.L, -a * 2 * 2, 0.L},
-            {0.L, 0.L, a * 3 * 3},
-            {0.L, 0.L, -a * 3 * 3},
-
-            {5e-10L + 1e-15L, 0.L, 0.L},
-            {5e-10L + -1e-15L, 0.L, 0.L},
-            {5e-10L + 0.L, 1e-15L, 0.L},
-            {5e-10L + 0.L, -1e-15L, 0.L},
-            {5e-10L + 0.L, 0.L, 1e-15L},
-            {5e-10L + 0.L, 0.L, -1e-15L},
-            {5e-10L + 1e-15L, 1e-15L, 0.L},
-            {5e-10L + -1e-15L, 1e-15L, 0.L},
-            {5e-10L + 0.L, 1e-15L, 1e-15L},
-            {5e-10L + 0.L, -1e-15L, 1e-15L},
-            {5e-10L + 1e-15L, 0.L, 1e-15L},
-            {5e-10L + 1e-15L, 0.L, -1e-15L},
-            {5e-10L + a * 1 * 1, 0.L, 0.L},
-            {5e-10L + -a * 1 * 1, 0.L, 0.L},
-            {5e-10L + 0.L, a * 2 * 2, 0.L},
-            {5e-10L + 0.L, -a * 2 * 2, 0.L},
-            {5e-10L + 0.L, 0.L, a * 3 * 3},
-            {5e-10L + 0.L, 0.L, -a * 3 * 3},
-        },
-        // finite theory
-        {
-            {0.L, 0.L, 0.L},
-            //{-57025548112.2453L, 3197006916.08582L, 5283916036.50742L},
-            //{-57358990223.0187831L, 0.L, 0.L},
-            {-45922743041.70308L, 0.L, 0.L},
-            {26317771130.7392L, 105373484164.43L, 481049442.321637L},
-            {-40584904469.4072L, -146162841483.741L, 582517208.913105L},
-            {192608888576.284L, -72078449728.0548L, -5537406864.12226L},
-            {-230068941192.889L, -766153804794.071L, 9039825087.87588L},
-            {1359034179077.08L, -555461097003.149L, -48376702948.4567L},
-            {1905563957085.85L, 2247912953966.77L, -16532490448.7952L},
-            {1788083649521.39L, 4079380837677.57L, -125881827325.591L},
-            {-4043923627184.17L, 3575690969311.01L, 795204553555.504L},
-
-            {250000000000.L, -40000000000.L, 0.L},
-            {250000000000.L, -40000000000.L, 0.L},
-
-            {-50000000000.L, 50000000000.L, 0.L},
-            {0.L, 50000000000.L, 0.L},
-            {50000000000.L, 50000000000.L, 0.L},
-            {-50000000000.L, 0.L, 0.L},
-            {50000000000.L, 0.L, 0.L},
-            {-50000000000.L, -50000000000.L, 0.L},
-            {0.L, -50000000000.L, 0.L},
-            {50000000000.L, -50000000000.L, 0.L},
-
-            // galaxy:
-            {-4e20L * 8/4, 0.L, 0.L},
-            {-4e20L * 7/4, 0.L, 0.L},
-            {-4e20L * 6/4, 0.L, 0.L},
-            {-4e20L * 5/4, 0.L, 0.L},
-            {4e20L * 5/4, 0.L, 0.L},
-            {4e20L * 6/4, 0.L, 0.L},
-            {4e20L * 7/4, 0.L, 0.L},
-            {4e20L * 8/4, 0.L, 0.L},
-
-            {17048116800000.L, 0.L, 0.L},
-            {17048116800000.L, 0.L, 0.L},
-
-            // quarks positions:
-            {4.49183e-10, -9.91138e-10, 0},
-            {-5.41035e-11, 1.18697e-10, 0},
-            {-5.41035e-11, 1.18697e-10, 0},
-
-            {-5.37561e-11, 1.09574e-10, 0},
-            {-4.85478e-11, 1.20417e-10, 0},
-            {-5.41035e-11, 1.18697e-10, 0},
-
-            {0.5e-15L, -0.5e-15L, 0.L},
-            {0e-15L, -0e-15L, 0.L},
-            {-0.5e-15L, 0.5e-15L, 0.L},
-
-            // protons, neutrons and electrons:
-            {1e-15L, 0.L, 0.L},
-            {-1e-15L, 0.L, 0.L},
-            {0.L, 1e-15L, 0.L},
-            {0.L, -1e-15L, 0.L},
-            {0.L, 0.L, 1e-15L},
-            {0.L, 0.L, -1e-15L},
-            {1e-15L, 1e-15L, 0.L},
-            {-1e-15L, 1e-15L, 0.L},
-            {0.L, 1e-15L, 1e-15L},
-            {0.L, -1e-15L, 1e-15L},
-            {1e-15L, 0.L, 1e-15L},
-            {1e-15L, 0.L, -1e-15L},
-            {a * 1 * 1, 0.L, 0.L},
-            {-a * 1 * 1, 0.L, 0.L},
-            {0.L, a * 2 * 2, 0.L},
-            {0.L, -a * 2 * 2, 0.L},
-            {0.L, 0.L, a * 3 * 3},
-            {0.L, 0.L, -a * 3 * 3},
-
-            {5e-10L + 1e-15L, 0.L, 0.L},
-            {5e-10L + -1e-15L, 0.L, 0.L},
-            {5e-10L + 0.L, 1e-15L, 0.L},
-            {5e-10L + 0.L, -1e-15L, 0.L},
-            {5e-10L + 0.L, 0.L, 1e-15L},
-            {5e-10L + 0.L, 0.L, -1e-15L},
-            {5e-10L + 1e-15L, 1e-15L, 0.L},
-            {5e-10L + -1e-15L, 1e-15L, 0.L},
-            {5e-10L + 0.L, 1e-15L, 1e-15L},
-            {5e-10L + 0.L, -1e-15L, 1e-15L},
-            {5e-10L + 1e-15L, 0.L, 1e-15L},
-            {5e-10L + 1e-15L, 0.L, -1e-15L},
-            {5e-10L + a * 1 * 1, 0.L, 0.L},
-            {5e-10L + -a * 1 * 1, 0.L, 0.L},
-            {5e-10L + 0.L, a * 2 * 2, 0.L},
-            {5e-10L + 0.L, -a * 2 * 2, 0.L},
-            {5e-10L + 0.L, 0.L, a * 3 * 3},
-            {5e-10L + 0.L, 0.L, -a * 3 * 3},
-        }
-    };
-	
-	// initial velocity of each planet and photon
-    static const ::real vel[2][75][3] =
-	{
-        // newton:
-        {
-            {0.L, 0.L, 0.L},
-            //{-13058.0445420602L, -46493.5791091285L, -2772.42900405547L},
-            //{0.L, -48372.0145148178242L, 0.L},
-            {0.L, -59148.05641434967L, 0.L},
-            {-33720.199494784L, 8727.97495192353L, 2044.70922687897L},
-            {28173.5639447033L, -8286.58463896112L, 13.3258392757908L},
-            {9453.24519302534L, 24875.9047777036L, 333.149595901334L},
-            {12310.4853583322L, -3126.10777330552L, -250.842129088533L},
-            {3203.18660260855L, 8810.22721786771L, -260.876357307397L},
-            {-5198.23543233994L, 4090.32678482699L, 78.6156634354517L},
-            {-5005.88142339012L, 2215.0599004751L, 70.452880649377L},
-            {-2122.7269723267L, -4538.25658137665L, 1101.51599904528L},
-
-            {-300000.L, 0.L, 0.L},
-            {-300000.L, 0.L, 0.L},
-
-            {-50000.L, 50000.L, 0.L},
-            {0.L, 50000.L, 0.L},
-            {50000.L, 50000.L, 0.L},
-            {-80000L, 0.L, 0.L},
-            {80000L, 0.L, 0.L},
-            {-50000.L, -50000.L, 0.L},
-            {0.L, -50000.L, 0.L},
-            {50000.L, -50000.L, 0.L},
-
-            // galaxy:
-            {0.L, 7e4L * 4/4, 0.L},
-            {0.L, 7e4L * 4/3, 0.L},
-            {0.L, 7e4L * 4/2, 0.L},
-            {0.L, 7e4L * 4/1, 0.L},
-            {0.L, -7e4L * 4/1, 0.L},
-            {0.L, -7e4L * 4/2, 0.L},
-            {0.L, -7e4L * 4/3, 0.L},
-            {0.L, -7e4L * 4/4, 0.L},
-
-            {11992.L, 0.L, 0.L},
-            {11992.L, 0.L, 0.L},
-
-            // quarks velocities:
-            {33000 + 291299, -57000 + -646492, 0},
-            {33000 + -66047.5, -57000 + 129952, 0},
-            {33000 + -66048, -57000 + 129952, 0},
-
-            {33000 + -116641, -57000 + 398716, 0},
-            {33000 + -15606.4, -57000 + -211825, 0},
-            {33000 + 66046.2, -57000 + -129951, 0},
-
-            {0L, 0L, 0L},
-            {0L, 0L, 0L},
-            {0L, 0L, 0L},
-
-            // protons, neutrons and electrons:
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-#if 1
-            {0.L, sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
-            {0.L, -sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
-            {sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
-            {-sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
-            {0.L, 0.L, sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
-            {0.L, 0.L, -sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
-#endif
-
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 5e5L, 0.L},
-            {-5e5 + 0.L, -5e5L, 0.L},
-            {-5e5 + 5e5L, 0.L, 0.L},
-            {-5e5 + -5e5L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 5e5L},
-            {-5e5 + 0.L, 0.L, -5e5L}
-        },
-        // finite theory:
-        {
-            {0.L, 0.L, 0.L},
-            //{-13058.0445420602L, -46493.5791091285L, -2772.42900405547L},
-            //{0.L, -48372.0145148178242L, 0.L},
-            {0.L, -59148.05641434967L, 0.L},
-            {-33720.199494784L, 8727.97495192353L, 2044.70922687897L},
-            {28173.5639447033L, -8286.58463896112L, 13.3258392757908L},
-            {9453.24519302534L, 24875.9047777036L, 333.149595901334L},
-            {12310.4853583322L, -3126.10777330552L, -250.842129088533L},
-            {3203.18660260855L, 8810.22721786771L, -260.876357307397L},
-            {-5198.23543233994L, 4090.32678482699L, 78.6156634354517L},
-            {-5005.88142339012L, 2215.0599004751L, 70.452880649377L},
-            {-2122.7269723267L, -4538.25658137665L, 1101.51599904528L},
-
-            {-300000.L, 0.L, 0.L},
-            {-300000.L, 0.L, 0.L},
-
-            {-50000.L, 50000.L, 0.L},
-            {0.L, 50000.L, 0.L},
-            {50000.L, 50000.L, 0.L},
-            {-80000L, 0.L, 0.L},
-            {80000L, 0.L, 0.L},
-            {-50000.L, -50000.L, 0.L},
-            {0.L, -50000.L, 0.L},
-            {50000.L, -50000.L, 0.L},
-
-            // galaxy:
-            {0.L, 2.566161566333395e4L, 0.L},
-            {0.L, 2.368653289642146e4L, 0.L},
-            {0.L, 2.0657202132228e4L, 0.L},
-            {0.L, 1.561716195518291e4L, 0.L},
-            {0.L, -1.561716195518291e4L, 0.L},
-            {0.L, -2.0657202132228e4L, 0.L},
-            {0.L, -2.368653289642146e4L, 0.L},
-            {0.L, -2.566161566333395e4L, 0.L},
-
-            {11992.L, 0.L, 0.L},
-            {11992.L, 0.L, 0.L},
-
-            // quarks velocities:
-            {291299, -646492, 0},
-            {-66047.5, 129952, 0},
-            {-66048, 129952, 0},
-
-            {-116641, 398716, 0},
-            {-15606.4, -211825, 0},
-            {66046.2, -129951, 0},
-
-            {33000 + -116641, -57000 + 398716, 0},
-            {33000 + -15606.4, -57000 + -211825, 0},
-            {33000 + 66046.2, -57000 + -129951, 0},
-
-            // protons, neutrons and electrons:
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-            {0.L, 0.L, 0.L},
-#if 1
-            {0.L, sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
-            {0.L, -sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
-            {sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
-            {-sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
-            {0.L, 0.L, sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
-            {0.L, 0.L, -sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
-#endif
-
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 0.L},
-            {-5e5 + 0.L, 5e5L, 0.L},
-            {-5e5 + 0.L, -5e5L, 0.L},
-            {-5e5 + 5e5L, 0.L, 0.L},
-            {-5e5 + -5e5L, 0.L, 0.L},
-            {-5e5 + 0.L, 0.L, 5e5L},
-            {-5e5 + 0.L, 0.L, -5e5L}
-        }
-    };
-
-	// name, color, mass, position and velocity of each moving object
-    static const Planet Sun 	  ("Sun", 		Qt::yellow, 1.98911E+30L, 0, pos[0][0], vel[0][0], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Mercury   ("Mercury", 	Qt::red, 3.302E+23L, 0, pos[0][1], vel[0][1], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Venus 	  ("Venus", 	Qt::cyan, 4.8685E+24L, 0, pos[0][2], vel[0][2], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Earth 	  ("Earth", 	Qt::blue, 5.9736E+24L, 0, pos[0][3], vel[0][3], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Mars 	  ("Mars", 		Qt::yellow, 6.41850000000001E+23L, 0, pos[0][4], vel[0][4], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Jupiter   ("Jupiter", 	Qt::magenta, 1.8986E+27L, 0, pos[0][5], vel[0][5], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Saturn 	  ("Saturn", 	Qt::darkRed, 5.6842928E+26L, 0, pos[0][6], vel[0][6], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Uranus 	  ("Uranus", 	Qt::green, 8.68320000000002E+25L, 0, pos[0][7], vel[0][7], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Neptune   ("Neptune", 	Qt::darkBlue, 1.0243E+26L, 0, pos[0][8], vel[0][8], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Pluto 	  ("Pluto", 	Qt::darkGray, 1.27E+22L, 0, pos[0][9], vel[0][9], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-
-    static const Planet Photon1   ("Photon1", 	Qt::darkGreen, 3.7e-36L, 0, pos[0][10], vel[0][10], Planet::FT_Time, Planet::FT_Acceleration, Planet::LB, H[0], Eta);
-    static const Planet Photon2   ("Photon2", 	Qt::darkRed, 3.7e-36L, 0, pos[0][11], vel[0][11], Planet::NW_Time, Planet::NW_Acceleration, Planet::LB, H[0], Eta);
-
-    static const Planet Pioneer1   ("Pioneer1", 	Qt::darkGreen, 258.8L, 0, pos[0][28], vel[0][28], Planet::FT_Time, Planet::FT_Acceleration, Planet::V1, H[0], Eta);
-    static const Planet Pioneer2   ("Pioneer2", 	Qt::darkRed, 258.8L, 0, pos[0][29], vel[0][29], Planet::NW_Time, Planet::NW_Acceleration, Planet::V1, H[0], Eta);
-
-    static const Planet Quark1   ("Quark1", 	Qt::red, 3.92e-30, Q*2/3, pos[0][30], vel[0][30], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark2   ("Quark2", 	Qt::blue, 8.38e-30, -Q*1/3, pos[0][31], vel[0][31], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark3   ("Quark3", 	Qt::blue, 8.38e-30, -Q*1/3, pos[0][32], vel[0][32], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-
-    static const Planet Quark4   ("Quark4", 	Qt::red, 3.92e-30, Q*2/3, pos[0][33], vel[0][33], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark5   ("Quark5", 	Qt::red, 3.92e-30, Q*2/3, pos[0][34], vel[0][34], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark6   ("Quark6", 	Qt::blue, 8.38e-30, -Q*1/3, pos[0][35], vel[0][35], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-
-    static const Planet Quark7   ("Quark7", 	Qt::red, 3.92e-30, Q*2/3, pos[0][36], vel[0][36], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark8   ("Quark8", 	Qt::blue, 8.38e-30, -Q*1/3, pos[0][37], vel[0][37], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-    static const Planet Quark9   ("Quark9", 	Qt::blue, 8.38e-30, -Q*1/3, pos[0][38], vel[0][38], Planet::NW_Time, Planet::NW_Acceleration, Planet::QU, H[0], Eta);
-
-    static const Planet Proton1     ("Proton1",   Qt::red, 1.6726e-27, Q, pos[0][39], vel[0][39], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton2     ("Proton2",   Qt::red, 1.6726e-27, Q, pos[0][40], vel[0][40], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton3     ("Proton3",   Qt::red, 1.6726e-27, Q, pos[0][41], vel[0][41], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton4     ("Proton4",   Qt::red, 1.6726e-27, Q, pos[0][42], vel[0][42], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton5     ("Proton5",   Qt::red, 1.6726e-27, Q, pos[0][43], vel[0][43], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton6     ("Proton6",   Qt::red, 1.6726e-27, Q, pos[0][44], vel[0][44], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron1     ("Neutron1",   Qt::yellow, 1.6726e-27, 0, pos[0][45], vel[0][45], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron2     ("Neutron2",   Qt::yellow, 1.6726e-27, 0, pos[0][46], vel[0][46], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron3     ("Neutron3",   Qt::yellow, 1.6726e-27, 0, pos[0][47], vel[0][47], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron4     ("Neutron4",   Qt::yellow, 1.6726e-27, 0, pos[0][48], vel[0][48], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron5     ("Neutron5",   Qt::yellow, 1.6726e-27, 0, pos[0][49], vel[0][49], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron6     ("Neutron6",   Qt::yellow, 1.6726e-27, 0, pos[0][50], vel[0][50], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron1   ("Electron1", Qt::blue, 9.109e-31, -Q, pos[0][51], vel[0][51], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron2   ("Electron2", Qt::blue, 9.109e-31, -Q, pos[0][52], vel[0][52], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron3   ("Electron3", Qt::blue, 9.109e-31, -Q, pos[0][53], vel[0][53], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron4   ("Electron4", Qt::blue, 9.109e-31, -Q, pos[0][54], vel[0][54], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron5   ("Electron5", Qt::blue, 9.109e-31, -Q, pos[0][55], vel[0][55], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron6   ("Electron6", Qt::blue, 9.109e-31, -Q, pos[0][56], vel[0][56], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-
-    static const Planet Proton7     ("Proton7",   Qt::red, 1.6726e-27, Q, pos[0][57], vel[0][57], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton8     ("Proton8",   Qt::red, 1.6726e-27, Q, pos[0][58], vel[0][58], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton9     ("Proton9",   Qt::red, 1.6726e-27, Q, pos[0][59], vel[0][59], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton10     ("Proton10",   Qt::red, 1.6726e-27, Q, pos[0][60], vel[0][60], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton11     ("Proton11",   Qt::red, 1.6726e-27, Q, pos[0][61], vel[0][61], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Proton12     ("Proton12",   Qt::red, 1.6726e-27, Q, pos[0][62], vel[0][62], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron7     ("Neutron7",   Qt::yellow, 1.6726e-27, 0, pos[0][63], vel[0][63], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron8     ("Neutron8",   Qt::yellow, 1.6726e-27, 0, pos[0][64], vel[0][64], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron9     ("Neutron9",   Qt::yellow, 1.6726e-27, 0, pos[0][65], vel[0][65], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron10     ("Neutron10",   Qt::yellow, 1.6726e-27, 0, pos[0][66], vel[0][66], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron11     ("Neutron11",   Qt::yellow, 1.6726e-27, 0, pos[0][67], vel[0][67], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Neutron12     ("Neutron12",   Qt::yellow, 1.6726e-27, 0, pos[0][68], vel[0][68], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron7   ("Electron7", Qt::blue, 9.109e-31, -Q, pos[0][69], vel[0][69], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron8   ("Electron8", Qt::blue, 9.109e-31, -Q, pos[0][70], vel[0][70], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron9   ("Electron9", Qt::blue, 9.109e-31, -Q, pos[0][71], vel[0][71], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron10   ("Electron10", Qt::blue, 9.109e-31, -Q, pos[0][72], vel[0][72], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron11   ("Electron11", Qt::blue, 9.109e-31, -Q, pos[0][73], vel[0][73], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-    static const Planet Electron12   ("Electron12", Qt::blue, 9.109e-31, -Q, pos[0][74], vel[0][74], Planet::NW_Time, Planet::NW_Acceleration, Planet::NU, H[0], Eta);
-
-
-    static const Planet Core	  ("Core", 		Qt::black, 2E+11L, 0, pos[0][0], vel[0][0], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy1   ("Galaxy1", 	Qt::red, 50000L, 0, pos[0][12], vel[0][12], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy2   ("Galaxy2", 	Qt::cyan, 50000L, 0, pos[0][13], vel[0][13], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy3   ("Galaxy3", 	Qt::blue, 50000L, 0, pos[0][14], vel[0][14], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy4   ("Galaxy4", 	Qt::yellow, 50000L, 0, pos[0][15], vel[0][15], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy5   ("Galaxy5", 	Qt::magenta, 50000L, 0, pos[0][16], vel[0][16], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy6   ("Galaxy6", 	Qt::darkRed, 50000L, 0, pos[0][17], vel[0][17], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy7   ("Galaxy7", 	Qt::green, 50000L, 0, pos[0][18], vel[0][18], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-    static const Planet Galaxy8   ("Galaxy8", 	Qt::darkBlue, 50000L, 0, pos[0][19], vel[0][19], Planet::NW_Time, Planet::NW_Acceleration, Planet::BB, H[1], Eta);
-
-    static const Planet Buldge1    ("Buldge1", 	Qt::black, 2e10L * 2e30L, 0, pos[0][0], vel[0][0], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star11     ("Star11", 	Qt::red, 2e30L, 0, pos[0][20], vel[0][20], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star12     ("Star12", 	Qt::red, 2e30L, 0, pos[0][21], vel[0][21], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star13     ("Star13", 	Qt::red, 2e30L, 0, pos[0][22], vel[0][22], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star14     ("Star14", 	Qt::red, 2e30L, 0, pos[0][23], vel[0][23], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star15     ("Star15", 	Qt::red, 2e30L, 0, pos[0][24], vel[0][24], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star16     ("Star16", 	Qt::red, 2e30L, 0, pos[0][25], vel[0][25], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star17     ("Star17", 	Qt::red, 2e30L, 0, pos[0][26], vel[0][26], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star18     ("Star18", 	Qt::red, 2e30L, 0, pos[0][27], vel[0][27], Planet::NW_Time, Planet::NW_Acceleration, Planet::GR, H[2], Eta);
-
-    static const Planet Buldge2    ("Buldge2", 	Qt::black, 2e10L * 2e30L, 0, pos[1][0], vel[1][0], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star21     ("Star21", 	Qt::red, 2e30L, 0, pos[1][20], vel[1][20], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star22     ("Star22", 	Qt::red, 2e30L, 0, pos[1][21], vel[1][21], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star23     ("Star23", 	Qt::red, 2e30L, 0, pos[1][22], vel[1][22], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star24     ("Star24", 	Qt::red, 2e30L, 0, pos[1][23], vel[1][23], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star25     ("Star25", 	Qt::red, 2e30L, 0, pos[1][24], vel[1][24], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star26     ("Star26", 	Qt::red, 2e30L, 0, pos[1][25], vel[1][25], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star27     ("Star27", 	Qt::red, 2e30L, 0, pos[1][26], vel[1][26], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-    static const Planet Star28     ("Star28", 	Qt::red, 2e30L, 0, pos[1][27], vel[1][27], Planet::FT_Time, Planet::FT_Acceleration, Planet::GR, H[2], Eta);
-
-    switch (eType)
-	{
-	// perihelion precession disparity
-	case PP:
-		// store each planet using the Newton time formula
-        planet.reserve(10);
-        planet.push_back(Sun);
-        planet.push_back(Mercury);
-        planet.push_back(Venus);
-        planet.push_back(Earth);
-        planet.push_back(Mars);
-        planet.push_back(Jupiter);
-        planet.push_back(Saturn);
-        planet.push_back(Uranus);
-        planet.push_back(Neptune);
-        planet.push_back(Pluto);
-		
-		// copy & change each planet for the FT time formula
-        if (t == 1)
-            for (size_t i = 0; i < planet.size(); i ++)
-            {
-                planet[i].time = Planet::FT_Time;
-                planet[i].acceleration = Planet::FT_Acceleration;
-            }
-
-		break;
-	
-	// gravitational light bending
-	case LB:
-        // store the Sun & the photon using the Newton time formula
-        planet.reserve(2);
-        planet.push_back(Sun);
-
-        switch (t)
-        {
-        case 0: planet.push_back(Photon1); break;
-        case 1: planet.push_back(Photon2); break;
-        }
-
-        break;
-
-    // big bang
-    case BB:
-        // store the Sun & the planets using FT time formula
-        planet.reserve(9);
-        planet.push_back(Core);
-        planet.push_back(Galaxy1);
-        planet.push_back(Galaxy2);
-        planet.push_back(Galaxy3);
-        planet.push_back(Galaxy4);
-        planet.push_back(Galaxy5);
-        planet.push_back(Galaxy6);
-        planet.push_back(Galaxy7);
-        planet.push_back(Galaxy8);
-
-        // copy & change each planet for the FT time formula
-        if (t == 1)
-            for (size_t i = 0; i < planet.size(); i ++)
-            {
-                planet[i].time = Planet::FT_Time;
-                planet[i].acceleration = Planet::FT_Acceleration;
-            }
-
-        break;
-
-        // galactic rotation
-    case GR:
-        planet.reserve(9);
-
-        switch (t)
-        {
-        case 0:
-            // store the buldge & the stars using NW time formula
-            planet.push_back(Buldge1);
-            planet.push_back(Star11);
-            planet.push_back(Star12);
-            planet.push_back(Star13);
-            planet.push_back(Star14);
-            planet.push_back(Star15);
-            planet.push_back(Star16);
-            planet.push_back(Star17);
-            planet.push_back(Star18);
-            break;
-
-        case 1:
-            // store the buldge & the stars using FT time formula
-            planet.push_back(Buldge2);
-            planet.push_back(Star21);
-            planet.push_back(Star22);
-            planet.push_back(Star23);
-            planet.push_back(Star24);
-            planet.push_back(Star25);
-            planet.push_back(Star26);
-            planet.push_back(Star27);
-            planet.push_back(Star28);
-            break;
-        }
-
-        break;
-
-    // pioneer 10
-    case V1:
-        // store the Sun & the photon using the Newton time formula
-        planet.reserve(2);
-        planet.push_back(Sun);
-
-        switch (t)
-        {
-        case 0: planet.push_back(Pioneer1); break;
-        case 1: planet.push_back(Pioneer2); break;
-        }
-
-        break;
-
-    // atomic
-    case NU:
-        {
-            // store the Sun & the photon using the Newton time formula
-            planet.reserve(5);
-
-            planet.push_back(Proton1);
-            //planet.push_back(Neutron1);
-            planet.push_back(Electron1);
-            planet.push_back(Electron2);
-            planet.push_back(Electron3);
-            planet.push_back(Electron4);
-
-#if 0
-            ::real constexpr scale = 1e-14L;
-
-            double random[] = {dist(gen) * scale, dist(gen) * scale};
-
-            planet.push_back(Proton1);
-            planet.back().p[0] += random[0];
-            planet.back().p[1] += random[1];
-            planet.push_back(Neutron1);
-            planet.back().p[0] += random[0];
-            planet.back().p[1] += random[1];
-            planet.push_back(Electron3);
-            planet.back().p[0] += random[0];
-            planet.back().p[1] += random[1];
-            planet.push_back(Electron4);
-            planet.back().p[0] += random[0];
-            planet.back().p[1] += random[1];
-#endif
-
-            // copy & change each planet for the FT time formula
-            if (t == 1)
-                for (size_t i = 0; i < planet.size(); i ++)
-                {
-                    planet[i].time = Planet::FT_Time;
-                    planet[i].acceleration = Planet::FT_Acceleration;
-                }
-
-            break;
-        }
-
-    // quantum
-    case QU:
-        {
-            // store the Sun & the photon using the Newton time formula
-            ::real const x = 0, y = 0;
-
-#if 0
-            planet.reserve(6 * 20 * 20);
-
-            ::real constexpr scale = 1e-14L;
-
-            for (::real x = - scale; x < scale; x += scale / 10)
-                for (::real y = - scale; y < scale; y += scale / 10)
-                {
-                    double random[] = {dist(gen) * scale, dist(gen) * scale, dist(gen) * scale, dist(gen) * scale};
-
-                    {
-                        //planet.push_back(Quark1);
-                        //planet.back().p[0] += x + random[0];
-                        //planet.back().p[1] += y + random[1];
-                        planet.push_back(Quark2);
-                        planet.back().p[0] += x + random[0];
-                        planet.back().p[1] += y + random[1];
-                        planet.push_back(Quark3);
-                        planet.back().p[0] += x + random[0];
-                        planet.back().p[1] += y + random[1];
-
-                        planet.push_back(Quark4);
-                        planet.back().p[0] += x + random[2];
-                        planet.back().p[1] += y + random[3];
-                        planet.push_back(Quark5);
-                        planet.back().p[0] += x + random[2];
-                        planet.back().p[1] += y + random[3];
-                        planet.push_back(Quark6);
-                        planet.back().p[0] += x + random[2];
-                        planet.back().p[1] += y + random[3];
-                    }
-                }
-#endif
-
-            planet.reserve(3 * 2 * 2);
-
-            ::real constexpr scale = 1e-12L;
-
-#if 1
-            for (::real x = - scale; x < scale; x += scale / 2)
-                for (::real y = - scale; y < scale; y += scale / 2)
-#endif
-                {
-                    ::real random[] = {dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15};
-
-                    planet.push_back(Quark7);
-                    planet.back().p[0] += x + random[0];
-                    planet.back().p[1] += y + random[1];
-                    planet.push_back(Quark8);
-                    planet.back().p[0] += x + random[2];
-                    planet.back().p[1] += y + random[3];
-                    planet.push_back(Quark9);
-                    planet.back().p[0] += x + random[4];
-                    planet.back().p[1] += y + random[5];
-                }
-
-            // copy & change each planet for the FT time formula
-            if (t == 1)
-                for (size_t i = 0; i < planet.size(); i ++)
-                {
-                    planet[i].time = Planet::FT_Time;
-                    planet[i].acceleration = Planet::FT_Acceleration;
-                }
-
-            break;
-        }
-    }
-	
-//    if ((qApp->argc() > 0) && !buffer.load(qApp->argv()[1]))
-//        buffer.fill( palette().base().color() );
 //    setBackgroundMode( Qt::PaletteBase );
 #ifndef QT_NO_CURSOR
     setCursor( Qt::CrossCursor );
 #endif
 
-	startTimer(100);
+    // the thread owns the planets once started: the drawing reads these & the frames only
+    for (size_t i = 0; i < simulation.planet.size(); ++ i)
+    {
+        mass.push_back(simulation.planet[i].m);
+        color.push_back(simulation.planet[i].c);
+    }
 
-	// launch a thread for each planet or photon
-    new Dual(this);
+    setRate(60);
 }
 
 Canvas::~Canvas()
 {
 }
 
-void Canvas::slotPlanet(int i)
+void Canvas::setTime(::real dt)
 {
-	Scribble * p = static_cast<Scribble *>(topLevelWidget());
-	
-	++ i;
-
-#if 0
-    switch (eType)
-    {
-    case PP:
-    case LB:
-        // precession
-        for (size_t j = 0; j < planet.size(); ++ j)
-            for (int x = 0; x < 3; ++ x)
-            {
-                ostringstream s;
-
-                if (stats[i].mean[0].size() > 0)
-                {
-                    s.setf(ios::scientific, ios::floatfield);
-                    s << std::setprecision(numeric_limits<::real>::digits10);
-                    s << stats[i].precession[j][x];
-                }
-
-                p->pLabel[eType][j][x]->setText(s.str().c_str());
-            }
-
-        // anomaly
-        for (int x = 0; x < 3; ++ x)
-        {
-            ostringstream s;
-
-            if (stats[i].mean[0].size() > 0)
-            {
-                s.setf(ios::scientific, ios::floatfield);
-                s << std::setprecision(numeric_limits<::real>::digits10);
-                s << stats[i].precession[1][x] - stats[i].precession[0][x];
-            }
-
-            p->pLabel[eType][2][x]->setText(s.str().c_str());
-        }
-
-        // mean
-        for (int x = 0; x < 3; ++ x)
-        {
-            ostringstream s[4];
-
-            // median
-            if (stats[i].mean[0].size() > 0)
-            {
-                s[0].setf(ios::scientific, ios::floatfield);
-                s[0] << std::setprecision(numeric_limits<::real>::digits10);
-
-                set<::real>::iterator k = stats[i].mean[x].begin();
-                set<::real>::reverse_iterator l = stats[i].mean[x].rbegin();
-                advance(k, stats[i].mean[x].size() / 2);
-                advance(l, stats[i].mean[x].size() / 2);
-
-                const ::real median = (* k + * l) / 2;
-
-                s[0] << median;
-
-                // median absolute deviation
-                if (stats[i].mean[0].size() > 1)
-                {
-                    s[1].setf(ios::scientific, ios::floatfield);
-                    s[1] << std::setprecision(numeric_limits<::real>::digits10);
-
-                    set<::real> dev;
-                    for (set<::real>::iterator m = stats[i].mean[x].begin(); m != stats[i].mean[x].end(); ++ m)
-                        dev.insert(abs(* m - median));
-
-                    set<::real>::iterator m = dev.begin();
-                    set<::real>::reverse_iterator n = dev.rbegin();
-                    advance(m, dev.size() / 2);
-                    advance(n, dev.size() / 2);
-
-                    const ::real mad = (* m + * n) / 2;
-
-                    s[1] << mad;
-
-                    if (stats[i].best[1][x] > mad)
-                    {
-                        stats[i].best[0][x] = median;
-                        stats[i].best[1][x] = mad;
-                    }
-
-                    s[2].setf(ios::scientific, ios::floatfield);
-                    s[2] << std::setprecision(numeric_limits<::real>::digits10);
-
-                    s[3].setf(ios::scientific, ios::floatfield);
-                    s[3] << std::setprecision(numeric_limits<::real>::digits10);
-
-                    s[2] << stats[i].best[0][x];
-                    s[3] << stats[i].best[1][x];
-                }
-            }
+    simulation.dt = dt;
+}
 
-            p->pLabel[eType][3][x]->setText(s[0].str().c_str());
-            p->pLabel[eType][4][x]->setText(s[1].str().c_str());
-            p->pLabel[eType][5][x]->setText(s[2].str().c_str());
-            p->pLabel[eType][6][x]->setText(s[3].str().c_str());
-        }
-        break;
+/**
+	@brief			Frames per second: how often the canvas is drawn & the simulation publishes its state
+*/
 
-    case NU:
-    case QU:
-#if 0
-        // position
-        for (size_t j = 0; j < planet[i].size(); ++ j)
-            for (int x = 0; x < 3; ++ x)
-            {
-                ostringstream s;
+void Canvas::setRate(unsigned hz)
+{
+    if (timer)
+        killTimer(timer);
 
-                s.setf(ios::scientific, ios::floatfield);
-                s << std::setprecision(numeric_limits<::real>::digits10);
-                s << planet[i][j].p[x];
+    timer = startTimer(1000 / hz, Qt::PreciseTimer);
 
-                p->pLabel[eType][j][x]->setText(s.str().c_str());
-            }
-#endif
-        break;
-    }
-#endif
+    simulation.interval = std::chrono::milliseconds(1000 / hz);
 }
 
 void Canvas::slotGalaxy(int i)
@@ -1207,6 +164,11 @@ void Canvas::slotGalaxy(int i)
 
     ++ i;
 
+    Frame const & f = simulation.frames.front();
+
+    if (size_t(i) >= f.p.size())
+        return;
+
     switch (eType)
     {
     case BB:
@@ -1217,7 +179,7 @@ void Canvas::slotGalaxy(int i)
 
             s.setf(ios::scientific, ios::floatfield);
             s << std::setprecision(numeric_limits<::real>::digits10);
-            s << planet[i].p[x];
+            s << f.p[i][x];
 
             p->pLabel[eType][t][x]->setText(s.str().c_str());
         }
@@ -1228,7 +190,7 @@ void Canvas::slotGalaxy(int i)
 
             s.setf(ios::scientific, ios::floatfield);
             s << std::setprecision(numeric_limits<::real>::digits10);
-            s << planet[i].v[1][x];
+            s << f.v[i][x];
 
             p->pLabel[eType][t + 2][x]->setText(s.str().c_str());
         }
@@ -1239,7 +201,7 @@ void Canvas::slotGalaxy(int i)
 
             s.setf(ios::scientific, ios::floatfield);
             s << std::setprecision(numeric_limits<::real>::digits10);
-            s << planet[i].v[1][x] - planet[t].v[1][x];
+            s << f.v[i][x] - f.v[t][x];
 
             p->pLabel[eType][4][x]->setText(s.str().c_str());
         }
@@ -1254,32 +216,26 @@ void Canvas::timerEvent(QTimerEvent *)
     if (! isVisible())
         return;
 
-#if 1
-    {
-        QRect r(0, 0, width(), height());
-        QPainter painter;
-        painter.begin( &buffer );
-        painter.setBrush(Qt::white);
-        painter.drawRect(0, 0, width(), height());
-        painter.end();
-        bitBlt( this, r.x(), r.y(), &buffer, r.x(), r.y(), r.width(), r.height() );
+    // latest state published by the simulation, if any
+    simulation.frames.update();
 
-        update(r);
-    }
-#endif
+    Frame const & f = simulation.frames.front();
+
+    cycles.resize(f.cycles.size());
+    perihelia.resize(f.perihelia.size());
 
 #if 1
     if (q->pCheck->isChecked())
     {
         vector3 max = {numeric_limits<::real>::min(), numeric_limits<::real>::min(), numeric_limits<::real>::min()};
 
-        for (size_t j = 0; j < planet.size(); ++ j)
+        for (size_t j = 0; j < f.p.size(); ++ j)
         {
-            if (abs(planet[j].p[0]) > max[0])
-                max[0] = abs(planet[j].p[0]);
+            if (abs(f.p[j][0]) > max[0])
+                max[0] = abs(f.p[j][0]);
 
-            if (abs(planet[j].p[1]) > max[1])
-                max[1] = abs(planet[j].p[1]);
+            if (abs(f.p[j][1]) > max[1])
+                max[1] = abs(f.p[j][1]);
         }
 
         ::real new_scale = numeric_limits<::real>::min();
@@ -1298,17 +254,9 @@ void Canvas::timerEvent(QTimerEvent *)
     }
 #endif
 
-    //if (new_scale != scale && ! isinf(new_scale) && ! isnan(new_scale) && new_scale != numeric_limits<::real>::min())
-    ostringstream o[2];
-    o[0] << "Scale: " << scale;
-    o[1] << "Zoom: " << zoom;
-
-    q->pScale[t]->setText(o[0].str().c_str());
-    q->pZoom[t]->setText(o[1].str().c_str());
-
 #if 0
     {
-        QRect r((planet[0].p[0] / scale - 5 + width()/2), (planet[0].p[1] / scale - 5 + height()/2), 10, 10);
+        QRect r((f.p[0][0] / scale - 5 + width()/2), (f.p[0][1] / scale - 5 + height()/2), 10, 10);
         QPainter painter;
         painter.begin( &buffer );
         painter.setBrush(Qt::yellow);
@@ -1318,56 +266,52 @@ void Canvas::timerEvent(QTimerEvent *)
 
         update(r);
     }
+#endif
 
-    switch (eType)
+    QElapsedTimer clock;
+
+    clock.start();
+
+    // the trails then all the bodies in one pass, then one repaint of what changed
+    raster.begin();
+
+    if (trails.bodies() != f.p.size())
+        trails.resize(f.p.size());
+
+    for (size_t i = 0; i < f.p.size(); ++ i)
     {
-    case PP:
-    case LB:
-        for (size_t i = 0; i < planet.size(); ++ i)
+        // a point every 2 pixels at most
+        trails.insert(i, f.p[i][0], f.p[i][1], 2 * scale * zoom);
+
+        if (! q->pTrail->isChecked())
+            continue;
+
+        for (size_t k = 1; k < trails.size(i); ++ k)
         {
-            if (planet[i].updated)
-            {
-                for (int x = 0; x < 3; ++ x)
-                    stats[i].precession[t][x] = planet[i].ps[3][x] - planet[i].ps[4][x];
-            }
+            Trails<::real>::Point const & a = trails.at(i, k - 1), & b = trails.at(i, k);
 
-            if (planet[i].updated && planet[i].updated)
-            {
-                for (int x = 0; x < 3; ++ x)
-                    stats[i].mean[x].insert(stats[i].precession[1][x] - stats[i].precession[0][x]);
-            }
+            raster.line(a.x / (scale * zoom) + width()/2, a.y / (scale * zoom) + height()/2, b.x / (scale * zoom) + width()/2, b.y / (scale * zoom) + height()/2, color[i]);
         }
-        break;
     }
-#endif
 
-    for (size_t i = 0; i < planet.size(); ++ i)
+    for (size_t i = 0; i < f.p.size(); ++ i)
     {
-        ::real const radius = (planet[i].m / planet[0].m) / (scale * zoom / initial) + 4;
-
-        QRect e((planet[i].o[0] / (scale * zoom) - radius + width()/2), (planet[i].o[1] / (scale * zoom) - radius + height()/2), (2 * radius), (2 * radius));
+        ::real const radius = (mass[i] / mass[0]) / (scale * zoom / initial) + 4;
 
-        planet[i].o[0] = planet[i].p[0];
-        planet[i].o[1] = planet[i].p[1];
-        planet[i].o[2] = planet[i].p[2];
+        ::real const x = f.p[i][0] / (scale * zoom) + width()/2, y = f.p[i][1] / (scale * zoom) + height()/2;
 
-        vector3 normal(planet[i].netacceleration[0], planet[i].netacceleration[1], planet[i].netacceleration[2]);
-
-        const ::real norm2 = pow(normal[0], 2) + pow(normal[1], 2) + pow(normal[2], 2);
-        const ::real norm = sqrt(norm2);
-
-        QRect r((planet[i].o[0] / (scale * zoom) - radius + width()/2), (planet[i].o[1] / (scale * zoom) - radius + height()/2), (2 * radius), (2 * radius));
-        QPainter painter;
-        painter.begin( &buffer );
-        painter.setPen(planet[i].c);
-        painter.setBrush(planet[i].c);
-        painter.eraseRect(e);
-        painter.drawEllipse(r);
+        // far off the screen, or not a number
+        if (abs(x) < 1e8 && abs(y) < 1e8 && radius < 1e8)
+            raster.splat(int(floor(x)), int(floor(y)), int(radius), color[i]);
 
 #if 0
         {
-            QPointF start(planet[i].o[0] / (scale * zoom) + width()/2, planet[i].o[1] / (scale * zoom) + height()/2);
-            QPointF end((planet[i].o[0]) / (scale * zoom) + width()/2 + 20 / zoom * normal[0] / norm, (planet[i].o[1]) / (scale * zoom) + height()/2 + 20 / zoom * normal[1] / norm);
+            vector3 normal(f.a[i]);
+
+            const ::real norm = sqrt(pow(normal[0], 2) + pow(normal[1], 2) + pow(normal[2], 2));
+
+            QPointF start(f.p[i][0] / (scale * zoom) + width()/2, f.p[i][1] / (scale * zoom) + height()/2);
+            QPointF end(f.p[i][0] / (scale * zoom) + width()/2 + 20 / zoom * normal[0] / norm, f.p[i][1] / (scale * zoom) + height()/2 + 20 / zoom * normal[1] / norm);
 
             painter.drawLine(start, end);
 
@@ -1387,27 +331,64 @@ void Canvas::timerEvent(QTimerEvent *)
         }
 #endif
 
-        painter.end();
-        r |= e;
-        bitBlt( this, r.x(), r.y(), &buffer, r.x(), r.y(), r.width(), r.height() );
+        // shift of the perihelion, paired with the one of the other twin
+        if (perihelia[i] != f.perihelia[i])
+        {
+            if (eType == PP)
+            {
+                DualCanvas * d = static_cast<DualCanvas *>(parentWidget());
 
-        update(r);
+                d->perihelion(t, i, f.perihelion[i], f.perihelia[i] - perihelia[i]);
 
-        if (planet[i].updated)
-        {
-            //if (size_t(q->pPlanet[j]->currentIndex() + 1) == i)
-                slotPlanet(i - 1);
+                if (size_t(q->pPlanet[0]->currentIndex() + 1) == i)
+                    d->display(i);
+            }
 
-            planet[i].updated = false;
+            perihelia[i] = f.perihelia[i];
+        }
+
+        if (cycles[i] != f.cycles[i])
+        {
+            cycles[i] = f.cycles[i];
 
 #if 0
             if (size_t(q->pPlanet[1]->currentIndex() + 1) == i)
                 slotGalaxy(i - 1);
 
-            planet[1][i].updated = false;
+            simulation.planet[1][i].updated = false;
 #endif
         }
     }
+
+    update(raster.end());
+
+    frame = clock.nsecsElapsed() / 1e6;
+
+    // steps & simulated time per second, over half a second at least
+    if (! meter.isValid() || meter.hasExpired(500))
+    {
+        if (meter.isValid())
+        {
+            double const s = meter.elapsed() / 1e3;
+
+            speed[0] = (f.steps - meteredSteps) / s;
+            speed[1] = (f.time - meteredTime) / s;
+        }
+
+        meter.start();
+        meteredSteps = f.steps;
+        meteredTime = f.time;
+    }
+
+    //if (new_scale != scale && ! isinf(new_scale) && ! isnan(new_scale) && new_scale != numeric_limits<::real>::min())
+    ostringstream o[3];
+    o[0] << "Scale: " << scale;
+    o[1] << "Zoom: " << zoom << ", frame: " << std::fixed << std::setprecision(2) << frame << " ms";
+    o[2] << std::setprecision(3) << speed[0] << " steps/s, " << speed[1] << " s/s";
+
+    q->pScale[t]->setText(o[0].str().c_str());
+    q->pZoom[t]->setText(o[1].str().c_str());
+    q->pSpeed[t]->setText(o[2].str().c_str());
 }
 
 void Canvas::wheelEvent(QWheelEvent *event)
@@ -1426,8 +407,9 @@ void Canvas::wheelEvent(QWheelEvent *event)
 
 void Canvas::clearScreen()
 {
-    buffer.fill( palette().base().color() );
-    repaint();
+    raster.clear();
+    trails.clear();
+    update();
 }
 
 void Canvas::mousePressEvent( QMouseEvent *e )
@@ -1445,7 +427,7 @@ void Canvas::mouseMoveEvent( QMouseEvent *e )
 {
     if ( mousePressed ) {
         QPainter painter;
-        painter.begin( &buffer );
+        painter.begin( &raster.image );
         painter.setPen( Qt::gray );
         polyline[2] = polyline[1];
         polyline[1] = polyline[0];
@@ -1460,7 +442,7 @@ void Canvas::mouseMoveEvent( QMouseEvent *e )
         r.setRight( r.right() + pen.width() );
         r.setBottom( r.bottom() + pen.width() );
 
-        bitBlt( this, r.x(), r.y(), &buffer, r.x(), r.y(), r.width(), r.height() );
+        update(r);
     }
 }
 
@@ -1468,27 +450,21 @@ void Canvas::resizeEvent( QResizeEvent *e )
 {
     QWidget::resizeEvent( e );
 
-    int w = width() > buffer.width() ?
-            width() : buffer.width();
-    int h = height() > buffer.height() ?
-            height() : buffer.height();
+    int w = width() > raster.image.width() ?
+            width() : raster.image.width();
+    int h = height() > raster.image.height() ?
+            height() : raster.image.height();
 
-    buffer = QPixmap(w, h);
-
-    buffer.fill( palette().base().color() );
-//    bitBlt( &buffer, 0, 0, &tmp, 0, 0, tmp.width(), tmp.height() );
+    raster.resize(w, h, palette().base().color().rgb());
 }
 
 void Canvas::paintEvent( QPaintEvent *e )
 {
     QWidget::paintEvent( e );
 
-    QVector<QRect> rects = QVector<QRect>(e->region().begin(), e->region().end());
-    for ( uint i = 0; i < rects.count(); ++ i ) 
-	{
-        QRect r = rects[(int)i];
-        bitBlt( this, r.x(), r.y(), &buffer, r.x(), r.y(), r.width(), r.height() );
-    }
+    // one blit of the box to repaint
+    QPainter painter( this );
+    painter.drawImage( e->rect(), raster.image, e->rect() );
 }
 
 //------------------------------------------------------
@@ -1512,6 +488,162 @@ DualCanvas::DualCanvas(Canvas::Type eType, QWidget *parent)
 
     hlayout->addLayout(vlayout[0]);
     hlayout->addLayout(vlayout[1]);
+
+    // read before the thread owns the simulations
+    for (size_t i = 0; i < left->simulation.planet.size(); ++ i)
+        names.push_back(left->simulation.planet[i].n);
+
+    stats.resize(names.size());
+
+	// launch one thread for both twins
+    dual = new Dual(this);
+}
+
+DualCanvas::~DualCanvas()
+{
+    // before the simulations go
+    control.stop();
+    dual->wait();
+
+    delete dual;
+}
+
+/**
+	@brief			Pairs the shifts of the perihelion of a planet in both twins, orbit by orbit, into the statistics of their anomaly
+	@param t		Twin
+	@param i		Planet
+	@param p		Last perihelion, relative to the central body
+	@param k		Perihelia passed since the last one seen
+*/
+
+void DualCanvas::perihelion(size_t t, size_t i, const vector3 & p, size_t k)
+{
+    if (i >= stats.size() || k == 0)
+        return;
+
+    Stats & s = stats[i];
+
+    ::real const rho = sqrt(p * p);
+    vector3 const c(rho, atan2(p[1], p[0]), rho > 0 ? acos(p[2] / rho) : ::real(0));
+
+    // spread evenly over the orbits done between 2 frames
+    if (s.count[t] > 0)
+    {
+        vector3 d = (c - s.last[t]) / ::real(k);
+
+        // across the cut of atan2
+        d[1] = remainder(c[1] - s.last[t][1], ::real(2 * M_PI)) / ::real(k);
+
+        s.shift[t].insert(s.shift[t].end(), k, d);
+    }
+
+    s.last[t] = c;
+    s.count[t] += k;
+
+    // anomaly of each orbit done by both twins
+    while (! s.shift[0].empty() && ! s.shift[1].empty())
+    {
+        for (size_t j = 0; j < 2; ++ j)
+        {
+            s.precession[j] = s.shift[j].front();
+            s.shift[j].pop_front();
+        }
+
+        for (int x = 0; x < 3; ++ x)
+        {
+            ::real const anomaly = s.precession[1][x] - s.precession[0][x];
+
+            s.mean[x].insert(anomaly);
+            s.mad[x].insert(abs(anomaly - s.mean[x].median()));
+
+            // steadiest median so far
+            if (s.mean[x].size() > 1 && s.best[1][x] > s.mad[x].value())
+            {
+                s.best[0][x] = s.mean[x].median();
+                s.best[1][x] = s.mad[x].value();
+            }
+        }
+    }
+}
+
+/**
+	@brief			Shows the precession of a planet in both twins, their anomaly & its statistics in the labels of the tab
+	@param i		Planet
+*/
+
+void DualCanvas::display(size_t i)
+{
+	Scribble * p = static_cast<Scribble *>(topLevelWidget());
+
+    if (i >= stats.size())
+        return;
+
+    Stats const & s = stats[i];
+    Canvas::Type const eType = left->eType;
+
+    // precession
+    for (size_t j = 0; j < 2; ++ j)
+        for (int x = 0; x < 3; ++ x)
+        {
+            ostringstream o;
+
+            if (s.mean[0].size() > 0)
+            {
+                o.setf(ios::scientific, ios::floatfield);
+                o << std::setprecision(numeric_limits<::real>::digits10);
+                o << s.precession[j][x];
+            }
+
+            p->pLabel[eType][j][x]->setText(o.str().c_str());
+        }
+
+    // anomaly
+    for (int x = 0; x < 3; ++ x)
+    {
+        ostringstream o;
+
+        if (s.mean[0].size() > 0)
+        {
+            o.setf(ios::scientific, ios::floatfield);
+            o << std::setprecision(numeric_limits<::real>::digits10);
+            o << s.precession[1][x] - s.precession[0][x];
+        }
+
+        p->pLabel[eType][2][x]->setText(o.str().c_str());
+    }
+
+    // mean
+    for (int x = 0; x < 3; ++ x)
+    {
+        ostringstream o[4];
+
+        // median
+        if (s.mean[0].size() > 0)
+        {
+            o[0].setf(ios::scientific, ios::floatfield);
+            o[0] << std::setprecision(numeric_limits<::real>::digits10);
+            o[0] << s.mean[x].median();
+
+            // median absolute deviation
+            if (s.mean[0].size() > 1)
+            {
+                for (int k = 1; k < 4; ++ k)
+                {
+                    o[k].setf(ios::scientific, ios::floatfield);
+                    o[k] << std::setprecision(numeric_limits<::real>::digits10);
+                }
+
+                o[1] << s.mad[x].value();
+                o[2] << s.best[0][x];
+                o[3] << s.best[1][x];
+            }
+        }
+
+        p->pLabel[eType][3][x]->setText(o[0].str().c_str());
+        p->pLabel[eType][4][x]->setText(o[1].str().c_str());
+        p->pLabel[eType][5][x]->setText(o[2].str().c_str());
+        p->pLabel[eType][6][x]->setText(o[3].str().c_str());
+    }
 }
 
 //------------------------------------------------------
@@ -1519,24 +651,29 @@ DualCanvas::DualCanvas(Canvas::Type eType, QWidget *parent)
 Scribble::Scribble( QWidget *parent, const char *name )
     : QMainWindow( parent ), nc(0)
 {
-    ntime[0] = 100;
-	ntime[1] = 1;
-    ntime[2] = 1;
-    ntime[3] = 50000000000;
-    ntime[4] = 1;
-    ntime[5] = 1e-12;
-    ntime[6] = 1e-20;
+    for (unsigned i = 0; i < ntabs; ++ i)
+    {
+        ntime[i] = Simulation::defaultTime((Planet::Type) (i));
+        nfactor[i] = 0.;
+        npaused[i] = false;
+    }
 
     QMenu *file = new QMenu( "&File", this );
     file->addAction( "&Restart", this, SLOT(slotRestart()), Qt::CTRL+Qt::Key_R );
     file->addSeparator();
     file->addAction( "E&xit", qApp, SLOT(quit()), Qt::CTRL+Qt::Key_Q );
 
+    QMenu *run = new QMenu( "&Run", this );
+    run->addAction( "&Pause", this, SLOT(slotPause()), Qt::CTRL+Qt::Key_P );
+    run->addAction( "R&esume", this, SLOT(slotResume()), Qt::CTRL+Qt::Key_E );
+    run->addAction( "&Step", this, SLOT(slotStep()), Qt::CTRL+Qt::Key_T );
+
     QMenu *help = new QMenu( "&Help", this );
     help->addAction( "&About", this, SLOT(slotAbout()));
 
 	QMenuBar * menu = new QMenuBar( this );
     menu->addMenu( file );
+    menu->addMenu( run );
     menu->addSeparator();
     menu->addMenu( help );
 //	menu->setSeparator( QMenuBar::IPlanet::NWindowsStyle );
@@ -1557,6 +694,26 @@ Scribble::Scribble( QWidget *parent, const char *name )
     tools->addWidget(pTime);
     tools->addSeparator();
 
+    pFactor = new QDoubleSpinBox( tools );
+    pFactor->setRange(0, 1e35);
+    pFactor->setDecimals(6);
+    pFactor->setSingleStep(1);
+    pFactor->setToolTip("Real-Time Factor (simulated s per s, 0: as fast as possible)");
+    pFactor->setValue( nfactor[nc] );
+
+    tools->addWidget(pFactor);
+
+    pRate = new QComboBox(tools);
+    pRate->setToolTip("Display Rate");
+
+    for (unsigned hz : rate)
+        pRate->addItem(QString::number(hz) + " Hz");
+
+    pRate->setCurrentIndex(2);
+
+    tools->addWidget(pRate);
+    tools->addSeparator();
+
     pPlanet[0] = new QComboBox(tools);
     pPlanet[0]->setToolTip("Planet" );
     connect(pPlanet[0], SIGNAL(activated(int)), SLOT(slotPlanet(int)));
@@ -1572,6 +729,11 @@ Scribble::Scribble( QWidget *parent, const char *name )
     pCheck->setChecked(true);
 
     tools->addWidget(pCheck);
+
+    pTrail = new QCheckBox( "Trails", tools );
+    pTrail->setChecked(true);
+
+    tools->addWidget(pTrail);
     tools->addSeparator();
 
     pScale[0] = new QLabel( tools );
@@ -1590,6 +752,14 @@ Scribble::Scribble( QWidget *parent, const char *name )
     tools->addWidget(pZoom[1]);
     tools->addSeparator();
 
+    pSpeed[0] = new QLabel( tools );
+    pSpeed[1] = new QLabel( tools );
+
+    tools->addWidget(pSpeed[0]);
+    tools->addSeparator();
+    tools->addWidget(pSpeed[1]);
+    tools->addSeparator();
+
     addToolBar(tools);
 	
 	pTabWidget = new QTabWidget(this);
@@ -1674,11 +844,10 @@ Scribble::Scribble( QWidget *parent, const char *name )
             break;
         }
 
-        canvas[i] = new DualCanvas((Canvas::Type) (i), pTab[i]);
-		canvas[i]->setSizePolicy(QSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding));
+        // see build()
+        canvas[i] = nullptr;
 
         QBoxLayout * l = new QVBoxLayout(pTab[i]);
-	    l->addWidget( canvas[i] );
 
         QBoxLayout * h1 = new QHBoxLayout();
 		h1->addWidget(pLabel[i][0][0], 1);
@@ -1730,6 +899,39 @@ Scribble::Scribble( QWidget *parent, const char *name )
     //pTab[1]->hide();
 
     setCentralWidget( pTabWidget );
+
+    // forward the time interval & the real-time factor to the simulations of the current tab
+    connect(pTime, SIGNAL(valueChanged(double)), SLOT(slotTime(double)));
+    connect(pFactor, SIGNAL(valueChanged(double)), SLOT(slotFactor(double)));
+    connect(pRate, SIGNAL(activated(int)), SLOT(slotRate(int)));
+
+    // the first tab may be shown without a change
+    build(nc);
+    canvas[nc]->control.resume();
+}
+
+/**
+	@brief			Creates the canvases of a tab, their simulations & their thread, the first time it is shown
+	@param i		Tab
+*/
+
+void Scribble::build(unsigned i)
+{
+    if (canvas[i])
+        return;
+
+    canvas[i] = new DualCanvas((Canvas::Type) (i), pTab[i]);
+    canvas[i]->setSizePolicy(QSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding));
+    canvas[i]->setRate(rate[pRate->currentIndex()]);
+    canvas[i]->setFactor(nfactor[i]);
+
+    // planets around the Sun
+    if (i == 0)
+        for (size_t j = 1; j < canvas[i]->names.size(); ++ j)
+            pPlanet[0]->addItem(canvas[i]->names[j]);
+
+    // above the labels
+    static_cast<QBoxLayout *>(pTab[i]->layout())->insertWidget(0, canvas[i]);
 }
 
 void Scribble::slotRestart()
@@ -1743,95 +945,118 @@ void Scribble::slotClear()
     canvas[nc]->clearScreen();
 }
 
-void Scribble::slotPlanet(int)
+void Scribble::slotPlanet(int i)
 {
-	pLabel[0][0][0]->clear();
-	pLabel[0][0][1]->clear();
-	pLabel[0][0][2]->clear();
-	pLabel[0][1][0]->clear();
-	pLabel[0][1][1]->clear();
-	pLabel[0][1][2]->clear();
+    if (canvas[0])
+        canvas[0]->display(i + 1);
 }
 
 void Scribble::slotPP()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
 	nc = 0;
     pPlanet[0]->setEnabled(true);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotLB()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
 	nc = 1;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotBB()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
     nc = 2;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(true);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotGR()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
     nc = 3;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotV1()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
     nc = 4;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotNU()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
     nc = 5;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotQU()
 {
     ntime[nc] = pTime->value();
+    nfactor[nc] = pFactor->value();
 
     nc = 6;
     pPlanet[0]->setEnabled(false);
     pPlanet[1]->setEnabled(false);
     pTabWidget->setCurrentWidget(pTab[nc]);
     pTime->setValue( ntime[nc] );
+    pFactor->setValue( nfactor[nc] );
 }
 
 void Scribble::slotChanged(int i)
 {
+    // only the scenario shown runs
+    for (unsigned k = 0; k < ntabs; ++ k)
+        if (canvas[k] && int(k) != i)
+            canvas[k]->control.pause();
+
+    if (i >= 0 && unsigned(i) < ntabs)
+    {
+        build(i);
+
+        if (! npaused[i])
+            canvas[i]->control.resume();
+    }
+
     switch (i)
     {
     case 0: slotPP(); break;
@@ -1844,6 +1069,43 @@ void Scribble::slotChanged(int i)
     }
 }
 
+void Scribble::slotTime(double dt)
+{
+    canvas[nc]->setTime(dt);
+}
+
+void Scribble::slotFactor(double factor)
+{
+    canvas[nc]->setFactor(factor);
+}
+
+void Scribble::slotPause()
+{
+    npaused[nc] = true;
+    canvas[nc]->control.pause();
+}
+
+void Scribble::slotResume()
+{
+    npaused[nc] = false;
+    canvas[nc]->control.resume();
+}
+
+// one step of the twins, then paused
+void Scribble::slotStep()
+{
+    npaused[nc] = true;
+    canvas[nc]->control.step();
+}
+
+// same rate for every tab
+void Scribble::slotRate(int i)
+{
+    for (unsigned k = 0; k < ntabs; ++ k)
+        if (canvas[k])
+            canvas[k]->setRate(rate[i]);
+}
+
 void Scribble::slotAbout()
 {
     QMessageBox::about( this, "Finite Theory of the Universe", "\nCopyright (c) 2011-2015\n\nPhil Bouchard <pbouchard8@gmail.com>\n");
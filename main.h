@@ -19,12 +19,15 @@
 #ifndef SCRIBBLE_H
 #define SCRIBBLE_H
 
-#include <set>
-#include <cmath>
-#include <limits>
-#include <vector>
-#define BOOST_DISABLE_ASSERTS
-#include <boost/multiprecision/cpp_bin_float.hpp>
+
+#include "simulation.h"
+#include "statistics.h"
+#include "raster.h"
+#include "trail.h"
+#include "pacer.h"
+#include "runcontrol.h"
+
+#include <deque>
 
 #include <qcolor.h>
 #include <QtWidgets/QMainWindow>
@@ -43,6 +46,7 @@
 #include <QResizeEvent>
 #include <QMouseEvent>
 #include <QTimerEvent>
+#include <QElapsedTimer>
 #include <QPaintEvent>
 
 class QMouseEvent;
@@ -51,234 +55,17 @@ class QPaintEvent;
 class QToolButton;
 class QDoubleSpinBox;
 
-typedef double real;
-
-constexpr real c = 299792458.L;
-constexpr real G = 6.67428e-11L;
-constexpr real K = 8.987551e9L;
-constexpr real K_m = 1e-7L;
-constexpr real Eta = 1e-3; //0.0013342L;
-constexpr real Q = 1.602176634e-19L;
-constexpr real Q_m = 3.291e-9L; // C*m/s
-constexpr real H[] = {c*c/(G), 0., 1e20L};
-constexpr real a = 5.29e-11L;
-constexpr real r_0 = 1e-15L;
-
-struct vector3
-{
-    typedef real T;
-	static const size_t N = 3;
-
-	T elem_[N];
-
-	vector3()
-	{
-	}
-	
-	vector3(const T & b1, const T & b2, const T & b3)
-	{
-		elem_[0] = b1;
-		elem_[1] = b2;
-		elem_[2] = b3;
-	}
-
-    vector3 & operator = (const vector3 & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] = b.elem_[i];
-
-        return * this;
-	}
-
-	T & operator [] (const size_t n) 
-	{ 
-		return elem_[n]; 
-	}
-
-	const T & operator [] (const size_t n) const
-	{ 
-		return elem_[n]; 
-	}
-
-	real norm () const
-	{
-		real nnorm2 = 0.L;
-		
-		for (size_t i = 0; i < N; ++ i)
-			nnorm2 += elem_[i] * elem_[i];
-
-		return sqrt(nnorm2);
-	}
-
-	vector3 cross(const vector3 & b) const
-	{
-		vector3 result;
-
-		result[0] = elem_[1]*b.elem_[2] - elem_[2]*b.elem_[1];
-		result[1] = elem_[2]*b.elem_[0] - elem_[0]*b.elem_[2];
-		result[2] = elem_[0]*b.elem_[1] - elem_[1]*b.elem_[0];
-		
-		return result;
-	}
-
-	vector3 operator - () const
-	{
-		vector3 result;
-
-		for (size_t i = 0; i < N; ++ i)
-			result[i] = - elem_[i];
-		
-		return result;
-	}
-
-	real operator * (const vector3 & b) const
-	{
-		real ndot = 0.L;
-		
-		for (size_t i = 0; i < N; ++ i)
-			ndot += elem_[i] * b.elem_[i];
-
-		return ndot;
-	}
-
-	vector3 operator * (const real & b) const
-	{
-		vector3 result;
-
-		for (size_t i = 0; i < N; ++ i)
-			result[i] = elem_[i] * b;
-		
-		return result;
-	}
-
-	vector3 operator / (const real & b) const
-	{
-		vector3 result;
-
-		for (size_t i = 0; i < N; ++ i)
-			result[i] = elem_[i] / b;
-		
-		return result;
-	}
-
-	vector3 operator + (const vector3 & b) const
-	{
-		vector3 result;
-
-		for (size_t i = 0; i < N; ++ i)
-			result[i] = elem_[i] + b.elem_[i];
-		
-		return result;
-	}
-
-	vector3 operator - (const vector3 & b) const
-	{
-		vector3 result;
-
-		for (size_t i = 0; i < N; ++ i)
-			result[i] = elem_[i] - b.elem_[i];
-		
-		return result;
-	}
-
-	void operator += (const vector3 & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] += b.elem_[i];
-	}
-
-	void operator -= (const vector3 & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] -= b.elem_[i];
-	}
-
-	void operator *= (const vector3 & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] *= b.elem_[i];
-	}
-
-	void operator /= (const vector3 & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] /= b.elem_[i];
-	}
-
-	void operator += (const real & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] += b;
-	}
-
-	void operator -= (const real & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] -= b;
-	}
-
-	void operator *= (const real & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] *= b;
-	}
-
-	void operator /= (const real & b)
-	{
-		for (size_t i = 0; i < N; ++ i)
-			elem_[i] /= b;
-	}
-};
-
-struct Planet
-{
-    static real FT_Time(real m, real d, real h);
-    static real FT_Acceleration(real G, real m1, real d, real h);
-
-    static real NW_Time(real m, real d, real h);
-    static real NW_Acceleration(real G, real m1, real d, real h);
-
-    static inline size_t counter = 0;
-
-    char const * n;						// name
-    size_t id = counter ++;             // id
-    QColor c;							// color
-	real m;								// mass
-    real q;                             // charge
-	vector3 p;							// position
-    vector3 v[2];						// current & saved velocity
-    vector3 o;							// old position
-    vector3 netacceleration;   				// acceleration or acceleration
-    real tg[2], te[2];              	// current & old time intervals according to Newton or FT
-    bool first;                         // first cycle
-	bool updated;						// the cycle of the planet or the photon arrival line has been completed
-    vector3 pp[2];						// current & old saved positions on the perihelion
-    vector3 ps[5];						// current & old polar coordinates of pp
-    real (* time)(real, real, real);                    // function pointer to Newton time formula or FT time formula
-    real (* acceleration)(real, real, real, real);   	// function pointer to Newton time formula or FT acceleration formula
-    real hg, he;                             // fudge factor
-
-    enum Type {PP, LB, BB, GR, V1, NU, QU, CO} eType;		// is for the perihelion precession disparity or the gravitational light bending
-
-    Planet(char const * n, const QColor & c, real m, real q, const real pp[3], const real pv[3], real (* time)(real, real, real), real (* acceleration)(real, real, real, real), Type eType, real hg, real he)
-        : n(n), c(c), m(m), q(q), p(pp[0], pp[1], pp[2]), first(true), updated(false), time(time), acceleration(acceleration), eType(eType), hg(hg), he(he)
-	{
-        v[0] = vector3(pv[0], pv[1], pv[2]);
-	}
-	
-	void operator () (const std::vector<Planet> &p, const real & upper);
-};
-
 class Canvas;
+class DualCanvas;
 	
 class Dual : public QThread
 {
 public:
-    Dual(Canvas *);
+    Dual(DualCanvas *);
 	virtual void run();
 	
 protected:
-    Canvas * p;
+    DualCanvas * p;
 };
 
 
@@ -286,6 +73,7 @@ class Canvas : public QWidget
 {
     Q_OBJECT
 	friend class Dual;
+	friend class DualCanvas;
 
 public:
     enum Type {PP, LB, BB, GR, V1, NU, QU, CO} eType;
@@ -293,9 +81,10 @@ public:
     Canvas( Type eType, size_t t, QWidget *parent = 0);
     ~Canvas();
     void clearScreen();
+    void setTime(::real dt);
+    void setRate(unsigned hz);
 	
 protected slots:
-	void slotPlanet(int);
     void slotGalaxy(int);
 
 protected:
@@ -314,35 +103,33 @@ protected:
 
     bool mousePressed;
 
-    QPixmap buffer;
+    int timer = 0;                          // of the frames
+    QElapsedTimer meter;                    // since the last measure of the speed
+    size_t meteredSteps = 0;                // Frame::steps then
+    real meteredTime = 0.L;                 // Frame::time then
+    double speed[2] = {0., 0.};             // steps & simulated seconds per second
 
-    std::vector<Planet> planet;
+    Raster raster;
+    Trails<real> trails;                    // of the published positions
+    double frame = 0.;                      // time spent rendering the last frame (ms)
 
-    real initial = 0.L, scale = 0.L, zoom = 0.2L;
+    Simulation simulation;
+    std::vector<real> mass;                 // of each planet, copied before the thread starts
+    std::vector<unsigned> color;            // of each planet, copied before the thread starts
+    std::vector<size_t> cycles;             // Frame::cycles already handled
+    std::vector<size_t> perihelia;          // Frame::perihelia already handled
 
-    struct Stats
-	{
-		vector3 precession[2];
-		std::set<real> mean[3];
-		vector3 best[2];
-		
-		Stats()
-		{
-			best[1][0] = std::numeric_limits<real>::max();
-			best[1][1] = std::numeric_limits<real>::max();
-			best[1][2] = std::numeric_limits<real>::max();
-		}
-	};
-	
-    std::vector<Stats> stats;
+    real initial = 0.L, scale = 0.L, zoom = 0.2L;
 };
 
 class DualCanvas : public QWidget
 {
     Q_OBJECT
+	friend class Dual;
 
 public:
     DualCanvas(Canvas::Type eType, QWidget *parent = 0);
+    ~DualCanvas();
 
     void clearScreen()
     {
@@ -350,9 +137,54 @@ public:
         right->clearScreen();
     }
 
+    void setTime(::real dt)
+    {
+        left->setTime(dt);
+        right->setTime(dt);
+    }
+
+    void setRate(unsigned hz)
+    {
+        left->setRate(hz);
+        right->setRate(hz);
+    }
+
+    void setFactor(double factor)
+    {
+        pacer.factor = factor;
+    }
+
+    void perihelion(size_t t, size_t i, const vector3 & p, size_t k);
+    void display(size_t i);
+
+    RunControl control;                     // of the twins, paused until the tab is shown
+    std::vector<char const *> names;        // of the planets, copied before the thread starts
+
 protected:
     Canvas * left;
     Canvas * right;
+    Pacer pacer;                            // of the twins
+    Dual * dual;                            // stepping thread of the twins
+
+    struct Stats
+	{
+		vector3 last[2];                    // spherical coordinates (rho, phi, theta) of the last perihelion of each twin
+		size_t count[2] = {0, 0};           // perihelia of each twin seen
+		std::deque<vector3> shift[2];       // of the perihelion per orbit, not paired with the other twin yet
+		vector3 precession[2];              // last shifts paired
+		Median<real> mean[3];               // of the anomaly, exact
+		Quantile<real> mad[3];              // median absolute deviation from the running median, P-square estimate
+		vector3 best[2];
+
+		Stats()
+		{
+			best[1][0] = std::numeric_limits<real>::max();
+			best[1][1] = std::numeric_limits<real>::max();
+			best[1][2] = std::numeric_limits<real>::max();
+		}
+	};
+
+    std::vector<Stats> stats;               // of each planet
 };
 
 class Scribble : public QMainWindow
@@ -375,22 +207,37 @@ protected slots:
     void slotNU();
     void slotQU();
     void slotChanged(int);
+    void slotTime(double);
+    void slotRate(int);
+    void slotPause();
+    void slotResume();
+    void slotStep();
+    void slotFactor(double);
 	void slotAbout();
-	
+
+protected:
+    void build(unsigned i);
+
 public:
     static constexpr unsigned ntabs = 8;
 
     unsigned nc;
     real ntime[ntabs];
+    double nfactor[ntabs];
+    bool npaused[ntabs];                    // by the user
 
 	QTabWidget *pTabWidget;
-    DualCanvas* canvas[ntabs];
+    DualCanvas* canvas[ntabs];              // created when first shown
     QWidget * pTab[ntabs];
     QLabel *pLabel[ntabs][8][3];
     QDoubleSpinBox *pTime;
+    QDoubleSpinBox *pFactor;
+    QComboBox *pRate;
     QCheckBox *pCheck;
+    QCheckBox *pTrail;
     QLabel *pScale[2];
     QLabel *pZoom[2];
+    QLabel *pSpeed[2];
     QComboBox *pPlanet[2];
     QToolButton *bPColor, *bSave, *bClear;
 };
@@ -0,0 +1,92 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PACER_H
+#define PACER_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+/**
+	@brief			Holds a stepping thread to a real-time factor: simulated seconds per wall-clock second
+
+	pace() is called before each step with the simulated time: it sleeps while the simulation is
+	ahead of factor times the wall-clock time elapsed, and returns at once while it is behind, so
+	the steps then run back to back until they catch up. More than a second late, the lag is
+	forgiven rather than made up. A factor of 0 runs as fast as possible.
+
+	The sleep goes by slices of 50 ms at most, the factor read again after each one, until the
+	step is due or the running predicate turns false: pace() then returns false for the step to
+	be skipped, so a pause or a stop never waits for a slow factor.
+*/
+
+class Pacer
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    std::atomic<double> factor {0.};        // simulated seconds per second, or 0
+
+    template <typename Running>
+        bool pace(double time, Running running)
+        {
+            for (;;)
+            {
+                double const f = factor.load(std::memory_order_relaxed);
+
+                // the factor changed: from here
+                if (f != current)
+                {
+                    current = f;
+                    origin = clock::now();
+                    start = time;
+                }
+
+                if (f <= 0.)
+                    return true;
+
+                double const wall = std::chrono::duration<double>(clock::now() - origin).count();
+                double const ahead = (time - start) / f - wall;
+
+                if (ahead <= 0.)
+                {
+                    if (ahead < -1.)
+                    {
+                        origin = clock::now();
+                        start = time;
+                    }
+
+                    return true;
+                }
+
+                if (! running())
+                    return false;
+
+                std::this_thread::sleep_for(std::chrono::duration<double>(std::min(ahead, .05)));
+            }
+        }
+
+protected:
+    double current = 0.;                    // factor of origin & start
+    clock::time_point origin = clock::now();
+    double start = 0.;                      // simulated time at origin
+};
+
+#endif
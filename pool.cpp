@@ -0,0 +1,157 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pool.h"
+
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+/**
+	@brief			Starts the workers
+	@param threads	Threads running the chunks, the caller included (1: serial)
+*/
+
+Pool::Pool(size_t threads)
+    : workers(max<size_t>(threads, 1) - 1), queue(new Queue[workers])
+{
+    for (size_t i = 0; i < workers; ++ i)
+        worker.emplace_back(& Pool::work, this, i);
+}
+
+Pool::~Pool()
+{
+    {
+        lock_guard<mutex> lock(m);
+
+        stop = true;
+    }
+
+    cv.notify_all();
+
+    for (thread & t : worker)
+        t.join();
+}
+
+/**
+	@brief			Pool of all the simulations: FT_THREADS threads, or one per core
+*/
+
+Pool & Pool::shared()
+{
+    // never destroyed: the stepping threads may still use it at exit
+    static Pool * const pool = []
+    {
+        char const * const e = getenv("FT_THREADS");
+        size_t const n = e ? strtoul(e, nullptr, 10) : thread::hardware_concurrency();
+
+        return new Pool(max<size_t>(n, 1));
+    } ();
+
+    return * pool;
+}
+
+void Pool::submit(Job & job, size_t n, size_t grain)
+{
+    // a few chunks per thread so that the fast ones can steal from the slow ones
+    size_t const chunk = max(grain, (n + 4 * size() - 1) / (4 * size()));
+    size_t const chunks = (n + chunk - 1) / chunk;
+    size_t const first = next ++;
+
+    job.left.store(chunks, memory_order_relaxed);
+
+    for (size_t k = 0; k < chunks; ++ k)
+    {
+        Queue & q = queue[(first + k) % workers];
+
+        lock_guard<mutex> lock(q.m);
+
+        q.task.push_back(Task {& job, k * chunk, min(n, (k + 1) * chunk)});
+    }
+
+    {
+        lock_guard<mutex> lock(m);
+
+        queued += chunks;
+    }
+
+    cv.notify_all();
+}
+
+/**
+	@brief			Runs one chunk: the oldest of its own queue, or the newest of another one
+	@param self		Queue to start from
+	@param own		Whether the queue is the one of the calling worker
+	@return			false if every queue was empty
+*/
+
+bool Pool::execute(size_t self, bool own)
+{
+    Task task;
+    bool found = false;
+
+    for (size_t k = 0; k < workers && ! found; ++ k)
+    {
+        Queue & q = queue[(self + k) % workers];
+
+        lock_guard<mutex> lock(q.m);
+
+        if (q.task.empty())
+            continue;
+
+        if (k == 0 && own)
+        {
+            task = q.task.front();
+            q.task.pop_front();
+        }
+        else
+        {
+            task = q.task.back();
+            q.task.pop_back();
+        }
+
+        found = true;
+    }
+
+    if (! found)
+        return false;
+
+    -- queued;
+
+    task.job->call(task.job->f, task.b, task.e);
+    task.job->left.fetch_sub(1, memory_order_release);
+
+    return true;
+}
+
+void Pool::work(size_t self)
+{
+    while (true)
+    {
+        if (execute(self, true))
+            continue;
+
+        unique_lock<mutex> lock(m);
+
+        cv.wait(lock, [this] { return stop || queued > 0; });
+
+        if (stop)
+            return;
+    }
+}
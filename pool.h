@@ -0,0 +1,112 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <condition_variable>
+
+/**
+	@brief			Work-stealing thread pool shared by all the simulations
+
+	run() splits [0, n) into chunks spread over the queues of the workers; each worker takes the
+	chunks of its own queue first, then steals from the back of the others, and the calling thread
+	helps until its chunks are done. Which thread runs a chunk never changes what the chunk computes.
+*/
+
+class Pool
+{
+public:
+    explicit Pool(size_t threads);
+    ~Pool();
+
+    static Pool & shared();
+
+    // threads running the chunks, the caller included
+    size_t size() const
+    {
+        return workers + 1;
+    }
+
+    // calls f(b, e) over chunks [b, e) of [0, n) of at least grain indexes, in parallel
+    template <typename F>
+        void run(size_t n, size_t grain, const F & f)
+        {
+            if (workers == 0 || n <= grain)
+            {
+                if (n)
+                    f(0, n);
+
+                return;
+            }
+
+            Job job;
+
+            job.call = [] (const void * f, size_t b, size_t e) { (* static_cast<const F *>(f))(b, e); };
+            job.f = & f;
+
+            submit(job, n, grain);
+
+            while (job.left.load(std::memory_order_acquire))
+                if (! execute(next ++, false))
+                    std::this_thread::yield();
+        }
+
+protected:
+    struct Job
+    {
+        void (* call)(const void * f, size_t b, size_t e);
+        const void * f;
+        std::atomic<size_t> left;           // chunks not done yet
+    };
+
+    struct Task
+    {
+        Job * job;
+        size_t b, e;
+    };
+
+    struct Queue
+    {
+        std::mutex m;
+        std::deque<Task> task;
+    };
+
+    void submit(Job & job, size_t n, size_t grain);
+    bool execute(size_t self, bool own);
+    void work(size_t self);
+
+    size_t const workers;
+    std::unique_ptr<Queue[]> queue;         // one per worker
+    std::vector<std::thread> worker;
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::atomic<long> queued {0};           // chunks in the queues
+    std::atomic<size_t> next {0};           // queue the next submission or steal starts from
+    bool stop = false;
+};
+
+#endif
@@ -0,0 +1,208 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "raster.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+void Raster::Box::clip(int w, int h)
+{
+    x0 = max(x0, 0);
+    y0 = max(y0, 0);
+    x1 = min(x1, w);
+    y1 = min(y1, h);
+}
+
+QRect Raster::Box::rect() const
+{
+    return x0 < x1 && y0 < y1 ? QRect(x0, y0, x1 - x0, y1 - y0) : QRect();
+}
+
+/**
+	@brief			Reallocates the image, blank
+	@param background	Color of the blank pixels
+*/
+
+void Raster::resize(int w, int h, QRgb background)
+{
+    this->background = background;
+
+    image = QImage(w, h, QImage::Format_RGB32);
+
+    clear();
+}
+
+void Raster::clear()
+{
+    image.fill(background);
+
+    last = current = Box {0, 0, 0, 0};
+}
+
+/**
+	@brief			Starts a frame: erases the disks of the last one
+*/
+
+void Raster::begin()
+{
+    bits = reinterpret_cast<QRgb *>(image.bits());
+    stride = int(image.bytesPerLine() / sizeof(QRgb));
+
+    last = current;
+    last.clip(image.width(), image.height());
+
+    for (int y = last.y0; y < last.y1; ++ y)
+        fill(bits + y * stride + last.x0, bits + y * stride + last.x1, background);
+
+    current = Box {image.width(), image.height(), 0, 0};
+}
+
+/**
+	@brief			Draws a filled disk, clipped to the image
+	@param x		Column of the center
+	@param y		Row of the center
+	@param radius	In pixels
+	@param color	0xffRRGGBB
+*/
+
+void Raster::splat(int x, int y, int radius, QRgb color)
+{
+    int const w = image.width(), h = image.height();
+
+    // no larger than the image, whose rows it fills anyway
+    radius = min(radius, w + h);
+
+    // rows of the disk that are in the image
+    int const b = max(y - radius, 0), e = min(y + radius + 1, h);
+
+    if (b >= e || x + radius < 0 || x - radius >= w)
+        return;
+
+    for (int r = b; r < e; ++ r)
+    {
+        // half width of the row, the ends of the row clipped
+        int const d = r - y, s = int(sqrt(double(radius * radius - d * d)));
+        int const l = max(x - s, 0), u = min(x + s + 1, w);
+
+        if (l < u)
+            fill(bits + r * stride + l, bits + r * stride + u, color);
+    }
+
+    current.x0 = min(current.x0, x - radius);
+    current.y0 = min(current.y0, b);
+    current.x1 = max(current.x1, x + radius + 1);
+    current.y1 = max(current.y1, e);
+}
+
+/**
+	@brief			Draws a segment, clipped to the image (Liang-Barsky) then stepped pixel by pixel (Bresenham)
+	@param x0		Column of the start
+	@param y0		Row of the start
+	@param x1		Column of the end
+	@param y1		Row of the end
+	@param color	0xffRRGGBB
+*/
+
+void Raster::line(double x0, double y0, double x1, double y1, QRgb color)
+{
+    if (! (isfinite(x0) && isfinite(y0) && isfinite(x1) && isfinite(y1)))
+        return;
+
+    int const w = image.width(), h = image.height();
+
+    double const dx = x1 - x0, dy = y1 - y0;
+    double const p[] = {- dx, dx, - dy, dy}, q[] = {x0, w - 1 - x0, y0, h - 1 - y0};
+    double t0 = 0., t1 = 1.;
+
+    for (size_t k = 0; k < 4; ++ k)
+    {
+        if (p[k] == 0.)
+        {
+            // parallel to the edge, outside of it
+            if (q[k] < 0.)
+                return;
+
+            continue;
+        }
+
+        double const t = q[k] / p[k];
+
+        if (p[k] < 0.)
+            t0 = max(t0, t);
+        else
+            t1 = min(t1, t);
+    }
+
+    if (! (t0 <= t1))
+        return;
+
+    int x = int(lround(x0 + t0 * dx)), y = int(lround(y0 + t0 * dy));
+    int const u = int(lround(x0 + t1 * dx)), v = int(lround(y0 + t1 * dy));
+
+    int const sx = x < u ? 1 : -1, sy = y < v ? 1 : -1;
+    int const ax = abs(u - x), ay = - abs(v - y);
+
+    current.x0 = min(current.x0, min(x, u));
+    current.y0 = min(current.y0, min(y, v));
+    current.x1 = max(current.x1, max(x, u) + 1);
+    current.y1 = max(current.y1, max(y, v) + 1);
+
+    for (int e = ax + ay; ; )
+    {
+        bits[y * stride + x] = color;
+
+        if (x == u && y == v)
+            break;
+
+        int const e2 = 2 * e;
+
+        if (e2 >= ay)
+        {
+            e += ay;
+            x += sx;
+        }
+
+        if (e2 <= ax)
+        {
+            e += ax;
+            y += sy;
+        }
+    }
+}
+
+/**
+	@brief			Ends a frame
+	@return			What changed since the last frame
+*/
+
+QRect Raster::end()
+{
+    current.clip(image.width(), image.height());
+
+    // either box may be empty
+    if (last.x0 >= last.x1 || last.y0 >= last.y1)
+        return current.rect();
+
+    if (current.x0 >= current.x1 || current.y0 >= current.y1)
+        return last.rect();
+
+    return Box {min(last.x0, current.x0), min(last.y0, current.y0), max(last.x1, current.x1), max(last.y1, current.y1)}.rect();
+}
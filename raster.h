@@ -0,0 +1,61 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <QImage>
+#include <QRect>
+
+/**
+	@brief			Renders the bodies of a frame as filled disks & their trails as lines, straight into the
+					scanlines of a 32 bit image
+
+	Only the box covered by the disks of the last frame is erased (begin()); end() returns the box
+	of the last & of the current frames, the only one the widget needs to repaint, in one blit.
+*/
+
+class Raster
+{
+public:
+    QImage image;                           // Format_RGB32
+
+    void resize(int w, int h, QRgb background);
+    void clear();
+
+    void begin();
+    void splat(int x, int y, int radius, QRgb color);
+    void line(double x0, double y0, double x1, double y1, QRgb color);
+    QRect end();
+
+protected:
+    struct Box
+    {
+        int x0, y0, x1, y1;                 // [x0, x1) x [y0, y1), empty if x0 >= x1
+
+        void clip(int w, int h);
+        QRect rect() const;
+    };
+
+    QRgb background = 0xffffffff;
+    QRgb * bits = nullptr;                  // first scanline, for the current frame
+    int stride = 0;                         // pixels per scanline
+    Box last = {0, 0, 0, 0}, current = {0, 0, 0, 0};
+};
+
+#endif
@@ -0,0 +1,157 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "rotation.h"
+#include "kernel.h"
+#include "pool.h"
+
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+static constexpr ::real kpc = 3.0856775814913673e19L;
+
+/**
+	@brief			Reads the curve: one radius (kpc) & velocity (km/s) per line
+	@param file		Path of the data
+	@return			false if the file could not be read or has no point
+*/
+
+bool RotationCurve::load(char const * file)
+{
+    ifstream in(file);
+
+    if (! in)
+        return false;
+
+    point.clear();
+
+    for (::real r, v; in >> r >> v; )
+    {
+        // no circular orbit at the center
+        if (r <= 0.)
+            continue;
+
+        point.push_back(Point {r * kpc, v * 1e3});
+    }
+
+    return ! point.empty();
+}
+
+/**
+	@brief			Circular velocity of the model at each radius of the curve
+	@param law		Force law of the bulge
+	@param m		Mass of the bulge
+	@param h		Fudge factor of the bulge
+	@param v		Velocities (m/s), as many as points
+*/
+
+void RotationCurve::velocity(Law law, ::real m, ::real h, ::real * v) const
+{
+    Bodies::vector3 const zero(0.L, 0.L, 0.L);
+
+    kernel::Function<::real> const f = kernel::select<::real>(law);
+
+    // the bulge then the probes, at rest on the x axis: test particles of the one source
+    Bodies body;
+
+    body.push_back(zero, zero, m, 0.L);
+
+    for (Point const & p : point)
+        body.push_back(Bodies::vector3(p.r, 0.L, 0.L), zero, 0.L, 0.L);
+
+    for (size_t k = 0; k < point.size(); ++ k)
+        v[k] = sqrt(max(- point[k].r * f(body, k + 1, 0, 1, h, Eta).a[0], ::real(0.L)));
+}
+
+/**
+	@brief			Root mean square of the differences between the model & the observed velocities
+*/
+
+::real RotationCurve::rms(Law law, ::real m, ::real h) const
+{
+    vector<::real> v(point.size());
+
+    velocity(law, m, h, v.data());
+
+    ::real s = 0.L;
+
+    for (size_t k = 0; k < point.size(); ++ k)
+        s += (v[k] - point[k].v) * (v[k] - point[k].v);
+
+    return sqrt(s / point.size());
+}
+
+/**
+	@brief			Least-squares fit of the mass & of the fudge factor of the bulge
+	@param law		Force law of the bulge
+	@param lo		Lower bounds of the search (a bound equal to the upper one fixes the parameter)
+	@param hi		Upper bounds of the search
+	@param n		Grid points per free parameter, evenly spaced in logarithm
+	@param rounds	Grids, each one spanning 4 cells of the previous one around its best point, within [lo, hi]
+	@return			Best parameters found, with their residual
+*/
+
+RotationCurve::Fit RotationCurve::fit(Law law, Fit lo, Fit hi, size_t n, size_t rounds) const
+{
+    ::real const bottom[2] = {log(lo.m), log(lo.h)}, top[2] = {log(hi.m), log(hi.h)};
+    ::real l[2] = {bottom[0], bottom[1]}, u[2] = {top[0], top[1]};
+    size_t const count[2] = {l[0] < u[0] ? n : 1, l[1] < u[1] ? n : 1};
+
+    Fit best = {lo.m, lo.h, numeric_limits<::real>::infinity()};
+    vector<Fit> grid(count[0] * count[1]);
+
+    auto const at = [&](size_t d, size_t k) { return count[d] > 1 ? l[d] + (u[d] - l[d]) * k / (count[d] - 1) : l[d]; };
+
+    for (size_t r = 0; r < rounds; ++ r)
+    {
+        Pool::shared().run(grid.size(), 1, [&](size_t b, size_t e)
+        {
+            for (size_t k = b; k < e; ++ k)
+            {
+                Fit & g = grid[k];
+
+                g.m = exp(at(0, k / count[1]));
+                g.h = exp(at(1, k % count[1]));
+                g.rms = rms(law, g.m, g.h);
+            }
+        });
+
+        // first of the smallest residuals: the same whatever the threads
+        auto const i = min_element(grid.begin(), grid.end(), [] (const Fit & a, const Fit & b) { return a.rms < b.rms; });
+
+        if (i->rms < best.rms)
+            best = * i;
+
+        for (size_t d = 0; d < 2; ++ d)
+        {
+            if (count[d] == 1)
+                continue;
+
+            ::real const c = d ? log(best.h) : log(best.m), w = 2 * (u[d] - l[d]) / (count[d] - 1);
+
+            // never outside of [lo, hi]
+            l[d] = max(c - w, bottom[d]);
+            u[d] = min(c + w, top[d]);
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,58 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ROTATION_H
+#define ROTATION_H
+
+#include "simulation.h"
+
+#include <vector>
+
+/**
+	@brief			Observed rotation curve of a galaxy, against the circular velocity around a bulge point mass
+
+	The model velocity at radius r is sqrt(r a), a being what the force kernel of the law gives for
+	a probe at rest at r from the bulge of mass m & fudge factor h (the H[2] of the GR scenario).
+	fit() is a least-squares search of m & h on logarithmic grids: each grid is evaluated on the
+	shared pool, then narrowed around its best point.
+*/
+
+class RotationCurve
+{
+public:
+    struct Point
+    {
+        real r, v;                          // radius (m), velocity (m/s)
+    };
+
+    struct Fit
+    {
+        real m, h;                          // bulge mass (kg) & fudge factor
+        real rms;                           // root mean square of the velocity residuals (m/s)
+    };
+
+    std::vector<Point> point;
+
+    bool load(char const * file);
+
+    void velocity(Law law, real m, real h, real * v) const;
+    real rms(Law law, real m, real h) const;
+    Fit fit(Law law, Fit lo, Fit hi, size_t n = 16, size_t rounds = 16) const;
+};
+
+#endif
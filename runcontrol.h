@@ -0,0 +1,128 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RUNCONTROL_H
+#define RUNCONTROL_H
+
+#include <mutex>
+#include <cstddef>
+#include <condition_variable>
+
+/**
+	@brief			Pause, resume, single step & stop of a stepping thread, from another thread
+
+	The stepping thread calls proceed() before each step: it blocks on a condition variable while
+	paused with no single step pending, so a paused simulation costs no CPU, and returns false once
+	stopped, for the thread to return.
+*/
+
+class RunControl
+{
+public:
+    explicit RunControl(bool running = false)
+        : state(running ? RUN : PAUSE)
+    {
+    }
+
+    void resume()
+    {
+        set(RUN);
+    }
+
+    void pause()
+    {
+        set(PAUSE);
+    }
+
+    void stop()
+    {
+        set(STOP);
+    }
+
+    // n more steps, then paused
+    void step(size_t n = 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+
+            if (state == STOP)
+                return;
+
+            state = PAUSE;
+            pending += n;
+        }
+
+        cv.notify_all();
+    }
+
+    bool paused() const
+    {
+        std::lock_guard<std::mutex> lock(m);
+
+        return state == PAUSE && pending == 0;
+    }
+
+    // neither paused nor stopped, single steps aside
+    bool running() const
+    {
+        std::lock_guard<std::mutex> lock(m);
+
+        return state == RUN;
+    }
+
+    // stepping thread
+    bool proceed()
+    {
+        std::unique_lock<std::mutex> lock(m);
+
+        cv.wait(lock, [this] { return state != PAUSE || pending > 0; });
+
+        if (state == STOP)
+            return false;
+
+        if (state == PAUSE)
+            -- pending;
+
+        return true;
+    }
+
+protected:
+    enum State {RUN, PAUSE, STOP};
+
+    void set(State s)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+
+            // stopped for good
+            if (state != STOP)
+                state = s;
+
+            pending = 0;
+        }
+
+        cv.notify_all();
+    }
+
+    mutable std::mutex m;
+    std::condition_variable cv;
+    State state;
+    size_t pending = 0;                     // single steps left while paused
+};
+
+#endif
@@ -0,0 +1,1747 @@
+/**
+    Finite Theory Simulator
+    Copyright (c) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "simulation.h"
+#include "kernel.h"
+#include "tree.h"
+#include "pool.h"
+
+#include <cmath>
+#include <random>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+using namespace std;
+
+/**
+	@brief			Updates the bookkeeping of the planet or photon once it has moved
+	@param s		Previous position
+	@param p		Current position
+	@param v		Current velocity
+*/
+
+template <typename R>
+    void BasicPlanet<R>::update(const vector3 & s, const vector3 & p, const vector3 & v)
+    {
+    #if 0
+        // spherical coordinates
+        if (! first)
+        {
+            ps[2] = ps[1];
+            ps[1] = ps[0];
+        }
+
+        ps[0][0] = sqrt(pow(p[0], 2) + pow(p[1], 2) + pow(p[2], 2));
+        ps[0][1] = atan2(p[1], p[0]);
+        ps[0][2] = acos(p[2] / ps[0][0]);
+
+        if (first)
+        {
+            ps[2] = ps[0];
+            ps[1] = ps[0];
+        }
+    #endif
+
+        switch (eType)
+    	{
+        // perihelion precession: cycles counted by apsis()
+        case PP:
+            break;
+
+    	// gravitational light bending
+    	case LB:
+            if (s[0] >= -200000000000.L && p[0] < -200000000000.L)
+    		{
+    			pp[1] = pp[0];
+
+                ++ cycles;
+    		}
+    		break;
+
+        // big bang & pioneer 10
+        case BB:
+        case V1:
+            if (floor(s[0] / 1e10) != floor(p[0] / 1e10))
+            {
+                this->v[1] = v;
+
+                ++ cycles;
+            }
+            break;
+
+        case NU:
+        case QU:
+            ++ cycles;
+
+            break;
+
+        // galactic rotation: nothing counted, the stars are compared by their positions
+        case GR:
+        // no scenario
+        case CO:
+            break;
+        }
+
+        first = false;
+    }
+
+/**
+	@brief			Logs an apsis of the planet
+	@param a		Apsis found by the simulation
+*/
+
+template <typename R>
+    void BasicPlanet<R>::apsis(const Apsis & a)
+    {
+        apsides.push_back(a);
+
+        if (a.perihelion)
+            ++ perihelia;
+
+        if (eType == PP && a.perihelion)
+            ++ cycles;
+    }
+
+/**
+	@brief			Rate of advance of the longitude of the perihelion (rad/s): least squares slope over the logged perihelia
+*/
+
+template <typename R>
+    ::real BasicPlanet<R>::precession() const
+    {
+        ::real n = 0., st = 0., sl = 0., stt = 0., stl = 0., previous = 0., turns = 0.;
+
+        for (Apsis const & a : apsides)
+        {
+            if (! a.perihelion)
+                continue;
+
+            // longitude, unwrapped
+            ::real l = atan2(::real(a.p[1]), ::real(a.p[0]));
+
+            if (n > 0. && l + turns - previous > M_PI)
+                turns -= 2 * M_PI;
+            else if (n > 0. && l + turns - previous < - M_PI)
+                turns += 2 * M_PI;
+
+            l += turns;
+            previous = l;
+
+            // from the first apsis, to keep the sums small
+            ::real const t = ::real(a.time - apsides.front().time);
+
+            n += 1.;
+            st += t;
+            sl += l;
+            stt += t * t;
+            stl += t * l;
+        }
+
+        if (n < 2.)
+            return 0.;
+
+        return (n * stl - st * sl) / (n * stt - st * st);
+    }
+
+/**
+	@brief			Adds a sample of the path to the incoming or outgoing fit, if far enough from the central body
+	@param r		Position relative to the central body
+	@param v		Velocity relative to the central body
+
+	Far means at more than twice the impact parameter b, the distance of the central body to the
+	line of motion. Past a body at a distance r, a straight path is still deflected in proportion to
+	x = 1 - sqrt(1 - (b/r)^2): the direction of motion is fitted to the 2nd order in x on each side.
+*/
+
+template <typename R>
+    void BasicPlanet<R>::Asymptotes::insert(const vector3 & r, const vector3 & v)
+    {
+        R const d = r.norm(), w = v.norm();
+
+        if (w == 0.L)
+            return;
+
+        // impact parameter over the distance
+        R const br = r.cross(v).norm() / w / d;
+
+        if (2 * br > 1)
+            return;
+
+        // receding: outgoing
+        size_t const k = signbit(r * v) ? 0 : 1;
+        R const x = 1 - sqrt(1 - br * br);
+        R p = 1.L;
+
+        for (size_t e = 0; e < 5; ++ e, p *= x)
+        {
+            s[k][e] += p;
+
+            if (e < 3)
+                for (size_t c = 0; c < 3; ++ c)
+                    t[k][e][c] += p * v[c] / w;
+        }
+    }
+
+/**
+	@brief			Direction of motion extrapolated to an infinite distance (x = 0), or 0 without 3 samples
+	@param k		0: incoming, 1: outgoing
+*/
+
+template <typename R>
+    typename BasicPlanet<R>::vector3 BasicPlanet<R>::Asymptotes::direction(size_t k) const
+    {
+        vector3 a(0.L, 0.L, 0.L);
+
+        if (s[k][0] < 3)
+            return a;
+
+        // normal equations of the quadratic: the constant term by Cramer's rule
+        R const (& m)[5] = s[k];
+        R const det = m[0] * (m[2] * m[4] - m[3] * m[3]) - m[1] * (m[1] * m[4] - m[3] * m[2]) + m[2] * (m[1] * m[3] - m[2] * m[2]);
+
+        for (size_t c = 0; c < 3; ++ c)
+        {
+            R const b[3] = {t[k][0][c], t[k][1][c], t[k][2][c]};
+
+            a[c] = (b[0] * (m[2] * m[4] - m[3] * m[3]) - m[1] * (b[1] * m[4] - m[3] * b[2]) + m[2] * (b[1] * m[3] - m[2] * b[2])) / det;
+        }
+
+        return a;
+    }
+
+// angle between the incoming & outgoing asymptotes (rad)
+template <typename R>
+    ::real BasicPlanet<R>::Asymptotes::deflection() const
+    {
+        ::vector3 const a(direction(0)), b(direction(1));
+
+        return atan2(a.cross(b).norm(), a * b);
+    }
+
+template <typename R>
+    void BasicBodies<R>::push_back(const vector3 & p, const vector3 & v, R m, R q)
+    {
+        x.push_back(p[0]);
+        y.push_back(p[1]);
+        z.push_back(p[2]);
+        vx.push_back(v[0]);
+        vy.push_back(v[1]);
+        vz.push_back(v[2]);
+        this->m.push_back(m);
+        this->q.push_back(q);
+        ax.push_back(0.L);
+        ay.push_back(0.L);
+        az.push_back(0.L);
+        tg.push_back(0.L);
+        te.push_back(0.L);
+        jx.push_back(0.L);
+        jy.push_back(0.L);
+        jz.push_back(0.L);
+        ex.push_back(0.L);
+        ey.push_back(0.L);
+        ez.push_back(0.L);
+        evx.push_back(0.L);
+        evy.push_back(0.L);
+        evz.push_back(0.L);
+    }
+
+template <typename R>
+    BasicSimulation<R>::BasicSimulation(Scenario::Type eType, size_t t)
+        : eType(eType), t(t), dt(defaultTime(eType)), solver(defaultSolver(eType)), integrator(defaultIntegrator(eType)), center(defaultCenter(eType)), tree(new Tree)
+    {
+        // inlined kernel of each force law for this CPU
+        for (size_t c = 0; c < 2; ++ c)
+            for (size_t l = 0; l < std::tuple_size<Laws>::value; ++ l)
+            {
+                force[c][l] = kernel::select<R>(Law(l), false, c);
+                jerk[c][l] = kernel::select<R>(Law(l), true, c);
+            }
+
+        static std::random_device rd;
+        static std::mt19937 gen(rd());
+        static std::uniform_real_distribution<> dist(0.0, 1.0);
+
+    	// initial position of each planet and photon
+        static const ::real pos[2][75][3] =
+    	{
+            // newton
+            {
+                {0.L, 0.L, 0.L},
+                //{-57025548112.2453L, 3197006916.08582L, 5283916036.50742L},
+                //{-57358990223.0187831L, 0.L, 0.L},
+                {-45922743041.70308L, 0.L, 0.L},
+                {26317771130.7392L, 105373484164.43L, 481049442.321637L},
+                {-40584904469.4072L, -146162841483.741L, 582517208.913105L},
+                {192608888576.284L, -72078449728.0548L, -5537406864.12226L},
+                {-230068941192.889L, -766153804794.071L, 9039825087.87588L},
+                {1359034179077.08L, -555461097003.149L, -48376702948.4567L},
+                {1905563957085.85L, 2247912953966.77L, -16532490448.7952L},
+                {1788083649521.39L, 4079380837677.57L, -125881827325.591L},
+                {-4043923627184.17L, 3575690969311.01L, 795204553555.504L},
+
+                {250000000000.L, -40000000000.L, 0.L},
+                {250000000000.L, -40000000000.L, 0.L},
+
+                {-50000000000.L, 50000000000.L, 0.L},
+                {0.L, 50000000000.L, 0.L},
+                {50000000000.L, 50000000000.L, 0.L},
+                {-50000000000.L, 0.L, 0.L},
+                {50000000000.L, 0.L, 0.L},
+                {-50000000000.L, -50000000000.L, 0.L},
+                {0.L, -50000000000.L, 0.L},
+                {50000000000.L, -50000000000.L, 0.L},
+
+                // galaxy:
+                {-2.46e20L * 4/4, 0.L, 0.L},
+                {-2.46e20L * 3/4, 0.L, 0.L},
+                {-2.46e20L * 2/4, 0.L, 0.L},
+                {-2.46e20L * 1/4, 0.L, 0.L},
+                {2.46e20L * 1/4, 0.L, 0.L},
+                {2.46e20L * 2/4, 0.L, 0.L},
+                {2.46e20L * 3/4, 0.L, 0.L},
+                {2.46e20L * 4/4, 0.L, 0.L},
+
+                {17048116800000.L, 0.L, 0.L},
+                {17048116800000.L, 0.L, 0.L},
+
+                // quarks positions:
+                {5.41035e-11 + 4.49183e-10, -1.18697e-10 + -9.91138e-10, 0},
+                {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
+                {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
+
+                {5.41035e-11 + -5.37561e-11, -1.18697e-10 + 1.09574e-10, 0},
+                {5.41035e-11 + -4.85478e-11, -1.18697e-10 + 1.20417e-10, 0},
+                {5.41035e-11 + -5.41035e-11, -1.18697e-10 + 1.18697e-10, 0},
+
+                {0.5e-15L, -0.5e-15L, 0.L},
+                {0e-15L, -0e-15L, 0.L},
+                {-0.5e-15L, 0.5e-15L, 0.L},
+
+                // protons, neutrons and electrons:
+                {1e-15L, 0.L, 0.L},
+                {-1e-15L, 0.L, 0.L},
+                {0.L, 1e-15L, 0.L},
+                {0.L, -1e-15L, 0.L},
+                {0.L, 0.L, 1e-15L},
+                {0.L, 0.L, -1e-15L},
+                {1e-15L, 1e-15L, 0.L},
+                {-1e-15L, 1e-15L, 0.L},
+                {0.L, 1e-15L, 1e-15L},
+                {0.L, -1e-15L, 1e-15L},
+                {1e-15L, 0.L, 1e-15L},
+                {1e-15L, 0.L, -1e-15L},
+                {a * 1 * 1, 0.L, 0.L},
+                {-a * 1 * 1, 0.L, 0.L},
+                {0.L, a * 2 * 2, 0.L},
+                {0.L, -a * 2 * 2, 0.L},
+                {0.L, 0.L, a * 3 * 3},
+                {0.L, 0.L, -a * 3 * 3},
+
+                {5e-10L + 1e-15L, 0.L, 0.L},
+                {5e-10L + -1e-15L, 0.L, 0.L},
+                {5e-10L + 0.L, 1e-15L, 0.L},
+                {5e-10L + 0.L, -1e-15L, 0.L},
+                {5e-10L + 0.L, 0.L, 1e-15L},
+                {5e-10L + 0.L, 0.L, -1e-15L},
+                {5e-10L + 1e-15L, 1e-15L, 0.L},
+                {5e-10L + -1e-15L, 1e-15L, 0.L},
+                {5e-10L + 0.L, 1e-15L, 1e-15L},
+                {5e-10L + 0.L, -1e-15L, 1e-15L},
+                {5e-10L + 1e-15L, 0.L, 1e-15L},
+                {5e-10L + 1e-15L, 0.L, -1e-15L},
+                {5e-10L + a * 1 * 1, 0.L, 0.L},
+                {5e-10L + -a * 1 * 1, 0.L, 0.L},
+                {5e-10L + 0.L, a * 2 * 2, 0.L},
+                {5e-10L + 0.L, -a * 2 * 2, 0.L},
+                {5e-10L + 0.L, 0.L, a * 3 * 3},
+                {5e-10L + 0.L, 0.L, -a * 3 * 3},
+            },
+            // finite theory
+            {
+                {0.L, 0.L, 0.L},
+                //{-57025548112.2453L, 3197006916.08582L, 5283916036.50742L},
+                //{-57358990223.0187831L, 0.L, 0.L},
+                {-45922743041.70308L, 0.L, 0.L},
+                {26317771130.7392L, 105373484164.43L, 481049442.321637L},
+                {-40584904469.4072L, -146162841483.741L, 582517208.913105L},
+                {192608888576.284L, -72078449728.0548L, -5537406864.12226L},
+                {-230068941192.889L, -766153804794.071L, 9039825087.87588L},
+                {1359034179077.08L, -555461097003.149L, -48376702948.4567L},
+                {1905563957085.85L, 2247912953966.77L, -16532490448.7952L},
+                {1788083649521.39L, 4079380837677.57L, -125881827325.591L},
+                {-4043923627184.17L, 3575690969311.01L, 795204553555.504L},
+
+                {250000000000.L, -40000000000.L, 0.L},
+                {250000000000.L, -40000000000.L, 0.L},
+
+                {-50000000000.L, 50000000000.L, 0.L},
+                {0.L, 50000000000.L, 0.L},
+                {50000000000.L, 50000000000.L, 0.L},
+                {-50000000000.L, 0.L, 0.L},
+                {50000000000.L, 0.L, 0.L},
+                {-50000000000.L, -50000000000.L, 0.L},
+                {0.L, -50000000000.L, 0.L},
+                {50000000000.L, -50000000000.L, 0.L},
+
+                // galaxy:
+                {-4e20L * 8/4, 0.L, 0.L},
+                {-4e20L * 7/4, 0.L, 0.L},
+                {-4e20L * 6/4, 0.L, 0.L},
+                {-4e20L * 5/4, 0.L, 0.L},
+                {4e20L * 5/4, 0.L, 0.L},
+                {4e20L * 6/4, 0.L, 0.L},
+                {4e20L * 7/4, 0.L, 0.L},
+                {4e20L * 8/4, 0.L, 0.L},
+
+                {17048116800000.L, 0.L, 0.L},
+                {17048116800000.L, 0.L, 0.L},
+
+                // quarks positions:
+                {4.49183e-10, -9.91138e-10, 0},
+                {-5.41035e-11, 1.18697e-10, 0},
+                {-5.41035e-11, 1.18697e-10, 0},
+
+                {-5.37561e-11, 1.09574e-10, 0},
+                {-4.85478e-11, 1.20417e-10, 0},
+                {-5.41035e-11, 1.18697e-10, 0},
+
+                {0.5e-15L, -0.5e-15L, 0.L},
+                {0e-15L, -0e-15L, 0.L},
+                {-0.5e-15L, 0.5e-15L, 0.L},
+
+                // protons, neutrons and electrons:
+                {1e-15L, 0.L, 0.L},
+                {-1e-15L, 0.L, 0.L},
+                {0.L, 1e-15L, 0.L},
+                {0.L, -1e-15L, 0.L},
+                {0.L, 0.L, 1e-15L},
+                {0.L, 0.L, -1e-15L},
+                {1e-15L, 1e-15L, 0.L},
+                {-1e-15L, 1e-15L, 0.L},
+                {0.L, 1e-15L, 1e-15L},
+                {0.L, -1e-15L, 1e-15L},
+                {1e-15L, 0.L, 1e-15L},
+                {1e-15L, 0.L, -1e-15L},
+                {a * 1 * 1, 0.L, 0.L},
+                {-a * 1 * 1, 0.L, 0.L},
+                {0.L, a * 2 * 2, 0.L},
+                {0.L, -a * 2 * 2, 0.L},
+                {0.L, 0.L, a * 3 * 3},
+                {0.L, 0.L, -a * 3 * 3},
+
+                {5e-10L + 1e-15L, 0.L, 0.L},
+                {5e-10L + -1e-15L, 0.L, 0.L},
+                {5e-10L + 0.L, 1e-15L, 0.L},
+                {5e-10L + 0.L, -1e-15L, 0.L},
+                {5e-10L + 0.L, 0.L, 1e-15L},
+                {5e-10L + 0.L, 0.L, -1e-15L},
+                {5e-10L + 1e-15L, 1e-15L, 0.L},
+                {5e-10L + -1e-15L, 1e-15L, 0.L},
+                {5e-10L + 0.L, 1e-15L, 1e-15L},
+                {5e-10L + 0.L, -1e-15L, 1e-15L},
+                {5e-10L + 1e-15L, 0.L, 1e-15L},
+                {5e-10L + 1e-15L, 0.L, -1e-15L},
+                {5e-10L + a * 1 * 1, 0.L, 0.L},
+                {5e-10L + -a * 1 * 1, 0.L, 0.L},
+                {5e-10L + 0.L, a * 2 * 2, 0.L},
+                {5e-10L + 0.L, -a * 2 * 2, 0.L},
+                {5e-10L + 0.L, 0.L, a * 3 * 3},
+                {5e-10L + 0.L, 0.L, -a * 3 * 3},
+            }
+        };
+    	
+    	// initial velocity of each planet and photon
+        static const ::real vel[2][75][3] =
+    	{
+            // newton:
+            {
+                {0.L, 0.L, 0.L},
+                //{-13058.0445420602L, -46493.5791091285L, -2772.42900405547L},
+                //{0.L, -48372.0145148178242L, 0.L},
+                {0.L, -59148.05641434967L, 0.L},
+                {-33720.199494784L, 8727.97495192353L, 2044.70922687897L},
+                {28173.5639447033L, -8286.58463896112L, 13.3258392757908L},
+                {9453.24519302534L, 24875.9047777036L, 333.149595901334L},
+                {12310.4853583322L, -3126.10777330552L, -250.842129088533L},
+                {3203.18660260855L, 8810.22721786771L, -260.876357307397L},
+                {-5198.23543233994L, 4090.32678482699L, 78.6156634354517L},
+                {-5005.88142339012L, 2215.0599004751L, 70.452880649377L},
+                {-2122.7269723267L, -4538.25658137665L, 1101.51599904528L},
+
+                {-300000.L, 0.L, 0.L},
+                {-300000.L, 0.L, 0.L},
+
+                {-50000.L, 50000.L, 0.L},
+                {0.L, 50000.L, 0.L},
+                {50000.L, 50000.L, 0.L},
+                {-80000L, 0.L, 0.L},
+                {80000L, 0.L, 0.L},
+                {-50000.L, -50000.L, 0.L},
+                {0.L, -50000.L, 0.L},
+                {50000.L, -50000.L, 0.L},
+
+                // galaxy:
+                {0.L, 7e4L * 4/4, 0.L},
+                {0.L, 7e4L * 4/3, 0.L},
+                {0.L, 7e4L * 4/2, 0.L},
+                {0.L, 7e4L * 4/1, 0.L},
+                {0.L, -7e4L * 4/1, 0.L},
+                {0.L, -7e4L * 4/2, 0.L},
+                {0.L, -7e4L * 4/3, 0.L},
+                {0.L, -7e4L * 4/4, 0.L},
+
+                {11992.L, 0.L, 0.L},
+                {11992.L, 0.L, 0.L},
+
+                // quarks velocities:
+                {33000 + 291299, -57000 + -646492, 0},
+                {33000 + -66047.5, -57000 + 129952, 0},
+                {33000 + -66048, -57000 + 129952, 0},
+
+                {33000 + -116641, -57000 + 398716, 0},
+                {33000 + -15606.4, -57000 + -211825, 0},
+                {33000 + 66046.2, -57000 + -129951, 0},
+
+                {0L, 0L, 0L},
+                {0L, 0L, 0L},
+                {0L, 0L, 0L},
+
+                // protons, neutrons and electrons:
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+    #if 1
+                {0.L, sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
+                {0.L, -sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
+                {sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
+                {-sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
+                {0.L, 0.L, sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
+                {0.L, 0.L, -sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
+    #endif
+
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 5e5L, 0.L},
+                {-5e5 + 0.L, -5e5L, 0.L},
+                {-5e5 + 5e5L, 0.L, 0.L},
+                {-5e5 + -5e5L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 5e5L},
+                {-5e5 + 0.L, 0.L, -5e5L}
+            },
+            // finite theory:
+            {
+                {0.L, 0.L, 0.L},
+                //{-13058.0445420602L, -46493.5791091285L, -2772.42900405547L},
+                //{0.L, -48372.0145148178242L, 0.L},
+                {0.L, -59148.05641434967L, 0.L},
+                {-33720.199494784L, 8727.97495192353L, 2044.70922687897L},
+                {28173.5639447033L, -8286.58463896112L, 13.3258392757908L},
+                {9453.24519302534L, 24875.9047777036L, 333.149595901334L},
+                {12310.4853583322L, -3126.10777330552L, -250.842129088533L},
+                {3203.18660260855L, 8810.22721786771L, -260.876357307397L},
+                {-5198.23543233994L, 4090.32678482699L, 78.6156634354517L},
+                {-5005.88142339012L, 2215.0599004751L, 70.452880649377L},
+                {-2122.7269723267L, -4538.25658137665L, 1101.51599904528L},
+
+                {-300000.L, 0.L, 0.L},
+                {-300000.L, 0.L, 0.L},
+
+                {-50000.L, 50000.L, 0.L},
+                {0.L, 50000.L, 0.L},
+                {50000.L, 50000.L, 0.L},
+                {-80000L, 0.L, 0.L},
+                {80000L, 0.L, 0.L},
+                {-50000.L, -50000.L, 0.L},
+                {0.L, -50000.L, 0.L},
+                {50000.L, -50000.L, 0.L},
+
+                // galaxy:
+                {0.L, 2.566161566333395e4L, 0.L},
+                {0.L, 2.368653289642146e4L, 0.L},
+                {0.L, 2.0657202132228e4L, 0.L},
+                {0.L, 1.561716195518291e4L, 0.L},
+                {0.L, -1.561716195518291e4L, 0.L},
+                {0.L, -2.0657202132228e4L, 0.L},
+                {0.L, -2.368653289642146e4L, 0.L},
+                {0.L, -2.566161566333395e4L, 0.L},
+
+                {11992.L, 0.L, 0.L},
+                {11992.L, 0.L, 0.L},
+
+                // quarks velocities:
+                {291299, -646492, 0},
+                {-66047.5, 129952, 0},
+                {-66048, 129952, 0},
+
+                {-116641, 398716, 0},
+                {-15606.4, -211825, 0},
+                {66046.2, -129951, 0},
+
+                {33000 + -116641, -57000 + 398716, 0},
+                {33000 + -15606.4, -57000 + -211825, 0},
+                {33000 + 66046.2, -57000 + -129951, 0},
+
+                // protons, neutrons and electrons:
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+                {0.L, 0.L, 0.L},
+    #if 1
+                {0.L, sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
+                {0.L, -sqrt((K * Q * (a * 1 * 1)) * Eta / ((a * 1 * 1) * Eta + Q)), 0.L},
+                {sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
+                {-sqrt((K * Q * (a * 2 * 2)) * Eta / ((a * 2 * 2) * Eta + Q)), 0.L, 0.L},
+                {0.L, 0.L, sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
+                {0.L, 0.L, -sqrt((K * Q * (a * 3 * 3)) * Eta / ((a * 3 * 3) * Eta + Q))},
+    #endif
+
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 0.L},
+                {-5e5 + 0.L, 5e5L, 0.L},
+                {-5e5 + 0.L, -5e5L, 0.L},
+                {-5e5 + 5e5L, 0.L, 0.L},
+                {-5e5 + -5e5L, 0.L, 0.L},
+                {-5e5 + 0.L, 0.L, 5e5L},
+                {-5e5 + 0.L, 0.L, -5e5L}
+            }
+        };
+
+    	// name, color, mass, position and velocity of each moving object
+        static const Planet Sun 	  ("Sun", 		color::yellow, 1.98911E+30L, 0, pos[0][0], vel[0][0], NW, Planet::V1, H[0], Eta);
+        static const Planet Mercury   ("Mercury", 	color::red, 3.302E+23L, 0, pos[0][1], vel[0][1], NW, Planet::V1, H[0], Eta);
+        static const Planet Venus 	  ("Venus", 	color::cyan, 4.8685E+24L, 0, pos[0][2], vel[0][2], NW, Planet::V1, H[0], Eta);
+        static const Planet Earth 	  ("Earth", 	color::blue, 5.9736E+24L, 0, pos[0][3], vel[0][3], NW, Planet::V1, H[0], Eta);
+        static const Planet Mars 	  ("Mars", 		color::yellow, 6.41850000000001E+23L, 0, pos[0][4], vel[0][4], NW, Planet::V1, H[0], Eta);
+        static const Planet Jupiter   ("Jupiter", 	color::magenta, 1.8986E+27L, 0, pos[0][5], vel[0][5], NW, Planet::V1, H[0], Eta);
+        static const Planet Saturn 	  ("Saturn", 	color::darkRed, 5.6842928E+26L, 0, pos[0][6], vel[0][6], NW, Planet::V1, H[0], Eta);
+        static const Planet Uranus 	  ("Uranus", 	color::green, 8.68320000000002E+25L, 0, pos[0][7], vel[0][7], NW, Planet::V1, H[0], Eta);
+        static const Planet Neptune   ("Neptune", 	color::darkBlue, 1.0243E+26L, 0, pos[0][8], vel[0][8], NW, Planet::V1, H[0], Eta);
+        static const Planet Pluto 	  ("Pluto", 	color::darkGray, 1.27E+22L, 0, pos[0][9], vel[0][9], NW, Planet::V1, H[0], Eta);
+
+        static const Planet Photon1   ("Photon1", 	color::darkGreen, 3.7e-36L, 0, pos[0][10], vel[0][10], FT, Planet::LB, H[0], Eta, true);
+        static const Planet Photon2   ("Photon2", 	color::darkRed, 3.7e-36L, 0, pos[0][11], vel[0][11], NW, Planet::LB, H[0], Eta, true);
+
+        static const Planet Pioneer1   ("Pioneer1", 	color::darkGreen, 258.8L, 0, pos[0][28], vel[0][28], FT, Planet::V1, H[0], Eta, true);
+        static const Planet Pioneer2   ("Pioneer2", 	color::darkRed, 258.8L, 0, pos[0][29], vel[0][29], NW, Planet::V1, H[0], Eta, true);
+
+        static const Planet Quark1   ("Quark1", 	color::red, 3.92e-30, Q*2/3, pos[0][30], vel[0][30], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark2   ("Quark2", 	color::blue, 8.38e-30, -Q*1/3, pos[0][31], vel[0][31], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark3   ("Quark3", 	color::blue, 8.38e-30, -Q*1/3, pos[0][32], vel[0][32], NW, Planet::QU, H[0], Eta);
+
+        static const Planet Quark4   ("Quark4", 	color::red, 3.92e-30, Q*2/3, pos[0][33], vel[0][33], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark5   ("Quark5", 	color::red, 3.92e-30, Q*2/3, pos[0][34], vel[0][34], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark6   ("Quark6", 	color::blue, 8.38e-30, -Q*1/3, pos[0][35], vel[0][35], NW, Planet::QU, H[0], Eta);
+
+        static const Planet Quark7   ("Quark7", 	color::red, 3.92e-30, Q*2/3, pos[0][36], vel[0][36], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark8   ("Quark8", 	color::blue, 8.38e-30, -Q*1/3, pos[0][37], vel[0][37], NW, Planet::QU, H[0], Eta);
+        static const Planet Quark9   ("Quark9", 	color::blue, 8.38e-30, -Q*1/3, pos[0][38], vel[0][38], NW, Planet::QU, H[0], Eta);
+
+        static const Planet Proton1     ("Proton1",   color::red, 1.6726e-27, Q, pos[0][39], vel[0][39], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton2     ("Proton2",   color::red, 1.6726e-27, Q, pos[0][40], vel[0][40], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton3     ("Proton3",   color::red, 1.6726e-27, Q, pos[0][41], vel[0][41], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton4     ("Proton4",   color::red, 1.6726e-27, Q, pos[0][42], vel[0][42], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton5     ("Proton5",   color::red, 1.6726e-27, Q, pos[0][43], vel[0][43], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton6     ("Proton6",   color::red, 1.6726e-27, Q, pos[0][44], vel[0][44], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron1     ("Neutron1",   color::yellow, 1.6726e-27, 0, pos[0][45], vel[0][45], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron2     ("Neutron2",   color::yellow, 1.6726e-27, 0, pos[0][46], vel[0][46], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron3     ("Neutron3",   color::yellow, 1.6726e-27, 0, pos[0][47], vel[0][47], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron4     ("Neutron4",   color::yellow, 1.6726e-27, 0, pos[0][48], vel[0][48], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron5     ("Neutron5",   color::yellow, 1.6726e-27, 0, pos[0][49], vel[0][49], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron6     ("Neutron6",   color::yellow, 1.6726e-27, 0, pos[0][50], vel[0][50], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron1   ("Electron1", color::blue, 9.109e-31, -Q, pos[0][51], vel[0][51], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron2   ("Electron2", color::blue, 9.109e-31, -Q, pos[0][52], vel[0][52], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron3   ("Electron3", color::blue, 9.109e-31, -Q, pos[0][53], vel[0][53], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron4   ("Electron4", color::blue, 9.109e-31, -Q, pos[0][54], vel[0][54], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron5   ("Electron5", color::blue, 9.109e-31, -Q, pos[0][55], vel[0][55], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron6   ("Electron6", color::blue, 9.109e-31, -Q, pos[0][56], vel[0][56], NW, Planet::NU, H[0], Eta);
+
+        static const Planet Proton7     ("Proton7",   color::red, 1.6726e-27, Q, pos[0][57], vel[0][57], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton8     ("Proton8",   color::red, 1.6726e-27, Q, pos[0][58], vel[0][58], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton9     ("Proton9",   color::red, 1.6726e-27, Q, pos[0][59], vel[0][59], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton10     ("Proton10",   color::red, 1.6726e-27, Q, pos[0][60], vel[0][60], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton11     ("Proton11",   color::red, 1.6726e-27, Q, pos[0][61], vel[0][61], NW, Planet::NU, H[0], Eta);
+        static const Planet Proton12     ("Proton12",   color::red, 1.6726e-27, Q, pos[0][62], vel[0][62], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron7     ("Neutron7",   color::yellow, 1.6726e-27, 0, pos[0][63], vel[0][63], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron8     ("Neutron8",   color::yellow, 1.6726e-27, 0, pos[0][64], vel[0][64], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron9     ("Neutron9",   color::yellow, 1.6726e-27, 0, pos[0][65], vel[0][65], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron10     ("Neutron10",   color::yellow, 1.6726e-27, 0, pos[0][66], vel[0][66], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron11     ("Neutron11",   color::yellow, 1.6726e-27, 0, pos[0][67], vel[0][67], NW, Planet::NU, H[0], Eta);
+        static const Planet Neutron12     ("Neutron12",   color::yellow, 1.6726e-27, 0, pos[0][68], vel[0][68], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron7   ("Electron7", color::blue, 9.109e-31, -Q, pos[0][69], vel[0][69], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron8   ("Electron8", color::blue, 9.109e-31, -Q, pos[0][70], vel[0][70], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron9   ("Electron9", color::blue, 9.109e-31, -Q, pos[0][71], vel[0][71], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron10   ("Electron10", color::blue, 9.109e-31, -Q, pos[0][72], vel[0][72], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron11   ("Electron11", color::blue, 9.109e-31, -Q, pos[0][73], vel[0][73], NW, Planet::NU, H[0], Eta);
+        static const Planet Electron12   ("Electron12", color::blue, 9.109e-31, -Q, pos[0][74], vel[0][74], NW, Planet::NU, H[0], Eta);
+
+
+        static const Planet Core	  ("Core", 		color::black, 2E+11L, 0, pos[0][0], vel[0][0], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy1   ("Galaxy1", 	color::red, 50000L, 0, pos[0][12], vel[0][12], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy2   ("Galaxy2", 	color::cyan, 50000L, 0, pos[0][13], vel[0][13], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy3   ("Galaxy3", 	color::blue, 50000L, 0, pos[0][14], vel[0][14], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy4   ("Galaxy4", 	color::yellow, 50000L, 0, pos[0][15], vel[0][15], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy5   ("Galaxy5", 	color::magenta, 50000L, 0, pos[0][16], vel[0][16], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy6   ("Galaxy6", 	color::darkRed, 50000L, 0, pos[0][17], vel[0][17], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy7   ("Galaxy7", 	color::green, 50000L, 0, pos[0][18], vel[0][18], NW, Planet::BB, H[1], Eta);
+        static const Planet Galaxy8   ("Galaxy8", 	color::darkBlue, 50000L, 0, pos[0][19], vel[0][19], NW, Planet::BB, H[1], Eta);
+
+        static const Planet Buldge1    ("Buldge1", 	color::black, 2e10L * 2e30L, 0, pos[0][0], vel[0][0], NW, Planet::GR, H[2], Eta);
+        static const Planet Star11     ("Star11", 	color::red, 2e30L, 0, pos[0][20], vel[0][20], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star12     ("Star12", 	color::red, 2e30L, 0, pos[0][21], vel[0][21], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star13     ("Star13", 	color::red, 2e30L, 0, pos[0][22], vel[0][22], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star14     ("Star14", 	color::red, 2e30L, 0, pos[0][23], vel[0][23], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star15     ("Star15", 	color::red, 2e30L, 0, pos[0][24], vel[0][24], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star16     ("Star16", 	color::red, 2e30L, 0, pos[0][25], vel[0][25], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star17     ("Star17", 	color::red, 2e30L, 0, pos[0][26], vel[0][26], NW, Planet::GR, H[2], Eta, true);
+        static const Planet Star18     ("Star18", 	color::red, 2e30L, 0, pos[0][27], vel[0][27], NW, Planet::GR, H[2], Eta, true);
+
+        static const Planet Buldge2    ("Buldge2", 	color::black, 2e10L * 2e30L, 0, pos[1][0], vel[1][0], FT, Planet::GR, H[2], Eta);
+        static const Planet Star21     ("Star21", 	color::red, 2e30L, 0, pos[1][20], vel[1][20], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star22     ("Star22", 	color::red, 2e30L, 0, pos[1][21], vel[1][21], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star23     ("Star23", 	color::red, 2e30L, 0, pos[1][22], vel[1][22], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star24     ("Star24", 	color::red, 2e30L, 0, pos[1][23], vel[1][23], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star25     ("Star25", 	color::red, 2e30L, 0, pos[1][24], vel[1][24], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star26     ("Star26", 	color::red, 2e30L, 0, pos[1][25], vel[1][25], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star27     ("Star27", 	color::red, 2e30L, 0, pos[1][26], vel[1][26], FT, Planet::GR, H[2], Eta, true);
+        static const Planet Star28     ("Star28", 	color::red, 2e30L, 0, pos[1][27], vel[1][27], FT, Planet::GR, H[2], Eta, true);
+
+        switch (eType)
+    	{
+    	// perihelion precession disparity
+    	case Planet::PP:
+    		// store each planet using the Newton time formula
+            planet.reserve(10);
+            planet.push_back(Sun);
+            planet.push_back(Mercury);
+            planet.push_back(Venus);
+            planet.push_back(Earth);
+            planet.push_back(Mars);
+            planet.push_back(Jupiter);
+            planet.push_back(Saturn);
+            planet.push_back(Uranus);
+            planet.push_back(Neptune);
+            planet.push_back(Pluto);
+    		
+    		// copy & change each planet for the FT time formula
+            if (t == 1)
+                for (size_t i = 0; i < planet.size(); i ++)
+                {
+                    planet[i].law = FT;
+                }
+
+    		break;
+    	
+    	// gravitational light bending
+    	case Planet::LB:
+            // store the Sun & the photon using the Newton time formula
+            planet.reserve(2);
+            planet.push_back(Sun);
+
+            switch (t)
+            {
+            case 0: planet.push_back(Photon1); break;
+            case 1: planet.push_back(Photon2); break;
+            }
+
+            break;
+
+        // big bang
+        case Planet::BB:
+            // store the Sun & the planets using FT time formula
+            planet.reserve(9);
+            planet.push_back(Core);
+            planet.push_back(Galaxy1);
+            planet.push_back(Galaxy2);
+            planet.push_back(Galaxy3);
+            planet.push_back(Galaxy4);
+            planet.push_back(Galaxy5);
+            planet.push_back(Galaxy6);
+            planet.push_back(Galaxy7);
+            planet.push_back(Galaxy8);
+
+            // copy & change each planet for the FT time formula
+            if (t == 1)
+                for (size_t i = 0; i < planet.size(); i ++)
+                {
+                    planet[i].law = FT;
+                }
+
+            break;
+
+            // galactic rotation
+        case Planet::GR:
+            planet.reserve(9);
+
+            switch (t)
+            {
+            case 0:
+                // store the buldge & the stars using NW time formula
+                planet.push_back(Buldge1);
+                planet.push_back(Star11);
+                planet.push_back(Star12);
+                planet.push_back(Star13);
+                planet.push_back(Star14);
+                planet.push_back(Star15);
+                planet.push_back(Star16);
+                planet.push_back(Star17);
+                planet.push_back(Star18);
+                break;
+
+            case 1:
+                // store the buldge & the stars using FT time formula
+                planet.push_back(Buldge2);
+                planet.push_back(Star21);
+                planet.push_back(Star22);
+                planet.push_back(Star23);
+                planet.push_back(Star24);
+                planet.push_back(Star25);
+                planet.push_back(Star26);
+                planet.push_back(Star27);
+                planet.push_back(Star28);
+                break;
+            }
+
+            break;
+
+        // pioneer 10
+        case Planet::V1:
+            // store the Sun & the photon using the Newton time formula
+            planet.reserve(2);
+            planet.push_back(Sun);
+
+            switch (t)
+            {
+            case 0: planet.push_back(Pioneer1); break;
+            case 1: planet.push_back(Pioneer2); break;
+            }
+
+            break;
+
+        // atomic
+        case Planet::NU:
+            {
+                // store the Sun & the photon using the Newton time formula
+                planet.reserve(5);
+
+                planet.push_back(Proton1);
+                //planet.push_back(Neutron1);
+                planet.push_back(Electron1);
+                planet.push_back(Electron2);
+                planet.push_back(Electron3);
+                planet.push_back(Electron4);
+
+    #if 0
+                ::real constexpr scale = 1e-14L;
+
+                double random[] = {dist(gen) * scale, dist(gen) * scale};
+
+                planet.push_back(Proton1);
+                planet.back().p[0] += random[0];
+                planet.back().p[1] += random[1];
+                planet.push_back(Neutron1);
+                planet.back().p[0] += random[0];
+                planet.back().p[1] += random[1];
+                planet.push_back(Electron3);
+                planet.back().p[0] += random[0];
+                planet.back().p[1] += random[1];
+                planet.push_back(Electron4);
+                planet.back().p[0] += random[0];
+                planet.back().p[1] += random[1];
+    #endif
+
+                // copy & change each planet for the FT time formula
+                if (t == 1)
+                    for (size_t i = 0; i < planet.size(); i ++)
+                    {
+                        planet[i].law = FT;
+                    }
+
+                break;
+            }
+
+        // quantum
+        case Planet::QU:
+            {
+                // store the Sun & the photon using the Newton time formula
+                ::real const x = 0, y = 0;
+
+    #if 0
+                planet.reserve(6 * 20 * 20);
+
+                ::real constexpr scale = 1e-14L;
+
+                for (::real x = - scale; x < scale; x += scale / 10)
+                    for (::real y = - scale; y < scale; y += scale / 10)
+                    {
+                        double random[] = {dist(gen) * scale, dist(gen) * scale, dist(gen) * scale, dist(gen) * scale};
+
+                        {
+                            //planet.push_back(Quark1);
+                            //planet.back().p[0] += x + random[0];
+                            //planet.back().p[1] += y + random[1];
+                            planet.push_back(Quark2);
+                            planet.back().p[0] += x + random[0];
+                            planet.back().p[1] += y + random[1];
+                            planet.push_back(Quark3);
+                            planet.back().p[0] += x + random[0];
+                            planet.back().p[1] += y + random[1];
+
+                            planet.push_back(Quark4);
+                            planet.back().p[0] += x + random[2];
+                            planet.back().p[1] += y + random[3];
+                            planet.push_back(Quark5);
+                            planet.back().p[0] += x + random[2];
+                            planet.back().p[1] += y + random[3];
+                            planet.push_back(Quark6);
+                            planet.back().p[0] += x + random[2];
+                            planet.back().p[1] += y + random[3];
+                        }
+                    }
+    #endif
+
+                planet.reserve(3 * 2 * 2);
+
+                ::real constexpr scale = 1e-12L;
+
+    #if 1
+                for (::real x = - scale; x < scale; x += scale / 2)
+                    for (::real y = - scale; y < scale; y += scale / 2)
+    #endif
+                    {
+                        ::real random[] = {dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15, dist(gen) * 0.5e-15};
+
+                        planet.push_back(Quark7);
+                        planet.back().p[0] += x + random[0];
+                        planet.back().p[1] += y + random[1];
+                        planet.push_back(Quark8);
+                        planet.back().p[0] += x + random[2];
+                        planet.back().p[1] += y + random[3];
+                        planet.push_back(Quark9);
+                        planet.back().p[0] += x + random[4];
+                        planet.back().p[1] += y + random[5];
+                    }
+
+                // copy & change each planet for the FT time formula
+                if (t == 1)
+                    for (size_t i = 0; i < planet.size(); i ++)
+                    {
+                        planet[i].law = FT;
+                    }
+
+                break;
+            }
+
+        // no bodies
+        case Planet::CO:
+            break;
+        }
+
+        load();
+        publish();
+    }
+
+template <typename R>
+    BasicSimulation<R>::~BasicSimulation()
+    {
+    }
+
+// default time interval of each scenario
+::real Numerics::defaultTime(Scenario::Type eType)
+{
+    switch (eType)
+    {
+    case Planet::PP: return 100;
+    case Planet::LB: return 1;
+    case Planet::BB: return 1;
+    case Planet::GR: return 50000000000;
+    case Planet::V1: return 1;
+    case Planet::NU: return 1e-12;
+    case Planet::QU: return 1e-20;
+    default: return 1;
+    }
+}
+
+// integrator of each scenario
+Numerics::Integrator Numerics::defaultIntegrator(Scenario::Type eType)
+{
+    switch (eType)
+    {
+    case Planet::PP: return YOSHIDA4;
+    case Planet::V1: return HERMITE;
+    default: return EULER;
+    }
+}
+
+// central body of the apsides & of the asymptotes of each scenario: the Sun
+size_t Numerics::defaultCenter(Scenario::Type eType)
+{
+    switch (eType)
+    {
+    case Planet::PP:
+    case Planet::LB: return 0;
+    default: return none;
+    }
+}
+
+// solver of each scenario
+Numerics::Solver Numerics::defaultSolver(Scenario::Type eType)
+{
+    switch (eType)
+    {
+    case Planet::BB:
+    case Planet::GR:
+    case Planet::NU:
+    case Planet::QU: return TREE;
+    default: return DIRECT;
+    }
+}
+
+/**
+	@brief			Adds a planet or photon to the scenario, before the first step
+	@param p		Bookkeeping & initial state of the body
+*/
+
+template <typename R>
+    void BasicSimulation<R>::insert(const Planet & p)
+    {
+        planet.push_back(p);
+
+        load();
+    }
+
+// hot state used by the force loop, from the bookkeeping: the sources first, then the test particles
+template <typename R>
+    void BasicSimulation<R>::load()
+    {
+        std::stable_partition(planet.begin(), planet.end(), [] (const Planet & p) { return ! p.test; });
+
+        sources = std::count_if(planet.begin(), planet.end(), [] (const Planet & p) { return ! p.test; });
+
+        * front = Bodies();
+
+        for (size_t i = 0; i < planet.size(); ++ i)
+            front->push_back(planet[i].p, planet[i].v[0], planet[i].m, planet[i].q);
+
+        * back = * front;
+
+        fresh = false;
+        rung.clear();
+    }
+
+/**
+	@brief			Calculates the net acceleration of a planet or photon
+	@param i		Index of the planet or photon that is moving
+*/
+
+template <typename R>
+    void BasicSimulation<R>::accelerate(size_t i)
+    {
+        Planet const & p = planet[i];
+
+        kernel::Sum<R> s;
+
+        // the tree has no jerk, nor the test particles
+        if (integrator == HERMITE)
+            s = jerk[compensated][p.law](* front, i, 0, sources, p.hg, p.he);
+        else if (solver == TREE && i < sources)
+            s = tree->force(p.law, i, p.hg, p.he);
+        else
+            s = force[compensated][p.law](* front, i, 0, sources, p.hg, p.he);
+
+        front->ax[i] = s.a[0];
+        front->ay[i] = s.a[1];
+        front->az[i] = s.a[2];
+        front->tg[i] = s.tg;
+        front->te[i] = s.te;
+
+        if (integrator == HERMITE)
+        {
+            front->jx[i] = s.j[0];
+            front->jy[i] = s.j[1];
+            front->jz[i] = s.j[2];
+        }
+    }
+
+/**
+	@brief			Moves every planet or photon once: each stage computes the next state aside, then swaps it in
+	@param dt		Time interval
+*/
+
+template <typename R>
+    void BasicSimulation<R>::step(::real dt)
+    {
+        begin();
+
+        if (integrator == BLOCK)
+        {
+            block(dt);
+            end(dt);
+            return;
+        }
+
+        for (size_t s = 0; s < stages(); ++ s)
+        {
+            if (stale(s))
+            {
+                prepare();
+
+                // all accelerations are taken from the same positions, each one by a single thread
+                Pool::shared().run(front->size(), 64, [this] (size_t b, size_t e)
+                {
+                    for (size_t i = b; i < e; ++ i)
+                        accelerate(i);
+                });
+
+                fresh = true;
+            }
+
+            stage(s, dt);
+        }
+
+        end(dt);
+    }
+
+namespace
+{
+    // kick v += d[s]*a*t, then drift p += c[s]*v*t, for each stage s
+    template <typename R>
+        struct Scheme
+        {
+            size_t n;
+            R d[8], c[8];
+        };
+
+    // 4th order triple jump {y1, y0} = {1, - 2^(1/3)} / (2 - 2^(1/3)), refined for the scalars beyond double
+    template <typename R>
+        std::pair<R, R> triple()
+        {
+            if (std::numeric_limits<R>::digits <= std::numeric_limits<::real>::digits)
+                return {1.35120719195965763405L, -1.70241438391931526810L};
+
+            R c = 1.25992104989487316476L;
+
+            for (size_t k = 0; k < 2; ++ k)
+                c -= (c * c * c - 2.L) / (3.L * c * c);
+
+            return {1.L / (2.L - c), - c / (2.L - c)};
+        }
+
+    template <typename R>
+        Scheme<R> const & scheme(Numerics::Integrator integrator)
+        {
+            static R const y1 = triple<R>().first, y0 = triple<R>().second;
+
+            // 6th order, solution A of Yoshida (1990), known to 21 digits
+            static R const z3 = 0.784513610477557263819L, z2 = 0.235573213359358133684L, z1 = -1.17767998417887100695L;
+            static R const z0 = 1.L - 2.L * (z1 + z2 + z3);
+
+            static Scheme<R> const table[] =
+            {
+                // EULER (see Simulation::stage)
+                {1, {1.L}, {1.L}},
+
+                // LEAPFROG: kick-drift-kick velocity Verlet
+                {2, {.5L, .5L}, {1.L, 0.L}},
+
+                // YOSHIDA4: 3 leapfrogs of y1, y0 & y1
+                {4, {y1 / 2, (y1 + y0) / 2, (y0 + y1) / 2, y1 / 2}, {y1, y0, y1, 0.L}},
+
+                // YOSHIDA6: 7 leapfrogs of z3, z2, z1, z0, z1, z2 & z3
+                {8, {z3 / 2, (z3 + z2) / 2, (z2 + z1) / 2, (z1 + z0) / 2, (z0 + z1) / 2, (z1 + z2) / 2, (z2 + z3) / 2, z3 / 2}, {z3, z2, z1, z0, z1, z2, z3, 0.L}},
+
+                // FOREST_RUTH: drift first, 3 kicks
+                {4, {0.L, y1, y0, y1}, {y1 / 2, (y1 + y0) / 2, (y0 + y1) / 2, y1 / 2}},
+
+                // BLOCK: leapfrog of the bodies of the coarsest level (see Simulation::block)
+                {2, {.5L, .5L}, {1.L, 0.L}},
+
+                // HERMITE: predictor, then corrector (see Simulation::stage)
+                {2, {1.L, 1.L}, {1.L, 0.L}},
+            };
+
+            return table[integrator];
+        }
+}
+
+template <typename R>
+    size_t BasicSimulation<R>::stages() const
+    {
+        return scheme<R>(integrator).n;
+    }
+
+// stage s kicks with accelerations that are not the ones of the current positions
+template <typename R>
+    bool BasicSimulation<R>::stale(size_t s) const
+    {
+        return scheme<R>(integrator).d[s] != 0.L && ! fresh;
+    }
+
+// what the force loop needs besides the positions
+template <typename R>
+    void BasicSimulation<R>::prepare()
+    {
+        if (solver == TREE && integrator != HERMITE)
+            tree->build(* front, sources);
+    }
+
+// positions & velocities the bookkeeping & the apsides compare with after the step
+template <typename R>
+    void BasicSimulation<R>::begin()
+    {
+        start[0].resize(front->size());
+        start[1].resize(front->size());
+
+        for (size_t i = 0; i < front->size(); ++ i)
+        {
+            start[0][i] = front->position(i);
+            start[1][i] = front->velocity(i);
+        }
+    }
+
+/**
+	@brief			Kicks then drifts the bodies once, from front to back, then swaps them
+	@param s		Stage of the integrator
+	@param dt		Time interval
+*/
+
+template <typename R>
+    void BasicSimulation<R>::stage(size_t s, R dt)
+    {
+        if (integrator == HERMITE)
+        {
+            hermite(s, dt);
+            return;
+        }
+
+        Bodies const & f = * front;
+        Bodies & b = * back;
+
+        if (integrator == EULER)
+            for (size_t i = 0; i < f.size(); ++ i)
+            {
+                // v = v + a*t
+                add(f.vx[i], f.evx[i], f.ax[i] * dt, b.vx[i], b.evx[i]);
+                add(f.vy[i], f.evy[i], f.ay[i] * dt, b.vy[i], b.evy[i]);
+                add(f.vz[i], f.evz[i], f.az[i] * dt, b.vz[i], b.evz[i]);
+
+                // p = p + v*t + (a*t^2)/2
+                add(f.x[i], f.ex[i], b.vx[i] * dt + f.ax[i] * dt * dt / 2, b.x[i], b.ex[i]);
+                add(f.y[i], f.ey[i], b.vy[i] * dt + f.ay[i] * dt * dt / 2, b.y[i], b.ey[i]);
+                add(f.z[i], f.ez[i], b.vz[i] * dt + f.az[i] * dt * dt / 2, b.z[i], b.ez[i]);
+            }
+        else
+        {
+            R const kick = scheme<R>(integrator).d[s] * dt, drift = scheme<R>(integrator).c[s] * dt;
+
+            for (size_t i = 0; i < f.size(); ++ i)
+            {
+                // v = v + d*a*t
+                add(f.vx[i], f.evx[i], f.ax[i] * kick, b.vx[i], b.evx[i]);
+                add(f.vy[i], f.evy[i], f.ay[i] * kick, b.vy[i], b.evy[i]);
+                add(f.vz[i], f.evz[i], f.az[i] * kick, b.vz[i], b.evz[i]);
+
+                // p = p + c*v*t
+                add(f.x[i], f.ex[i], b.vx[i] * drift, b.x[i], b.ex[i]);
+                add(f.y[i], f.ey[i], b.vy[i] * drift, b.y[i], b.ey[i]);
+                add(f.z[i], f.ez[i], b.vz[i] * drift, b.z[i], b.ez[i]);
+            }
+        }
+
+        // the accelerations of unmoved positions are reused by the next kick (velocities aside)
+        if (fresh && scheme<R>(integrator).c[s] == 0.L)
+        {
+            b.ax = f.ax;
+            b.ay = f.ay;
+            b.az = f.az;
+            b.tg = f.tg;
+            b.te = f.te;
+        }
+        else
+            fresh = false;
+
+        std::swap(front, back);
+    }
+
+/**
+	@brief			4th order Hermite: predicts from the accelerations & jerks, then corrects with the predicted ones
+	@param s		0: predictor, from front to back, then swapped; 1: corrector, in place
+	@param dt		Time interval
+
+	The corrector interpolates between the old state, left in back by the predictor, and the
+	accelerations & jerks of the predicted one in front, which the next predictor reuses.
+*/
+
+template <typename R>
+    void BasicSimulation<R>::hermite(size_t s, R dt)
+    {
+        if (s == 0)
+        {
+            Bodies const & f = * front;
+            Bodies & b = * back;
+
+            for (size_t i = 0; i < f.size(); ++ i)
+            {
+                // v = v + a*t + j*t^2/2
+                add(f.vx[i], f.evx[i], (f.ax[i] + f.jx[i] * dt / 2) * dt, b.vx[i], b.evx[i]);
+                add(f.vy[i], f.evy[i], (f.ay[i] + f.jy[i] * dt / 2) * dt, b.vy[i], b.evy[i]);
+                add(f.vz[i], f.evz[i], (f.az[i] + f.jz[i] * dt / 2) * dt, b.vz[i], b.evz[i]);
+
+                // p = p + v*t + a*t^2/2 + j*t^3/6
+                add(f.x[i], f.ex[i], (f.vx[i] + (f.ax[i] / 2 + f.jx[i] * dt / 6) * dt) * dt, b.x[i], b.ex[i]);
+                add(f.y[i], f.ey[i], (f.vy[i] + (f.ay[i] / 2 + f.jy[i] * dt / 6) * dt) * dt, b.y[i], b.ey[i]);
+                add(f.z[i], f.ez[i], (f.vz[i] + (f.az[i] / 2 + f.jz[i] * dt / 6) * dt) * dt, b.z[i], b.ez[i]);
+            }
+
+            fresh = false;
+
+            std::swap(front, back);
+
+            return;
+        }
+
+        Bodies & p = * front;
+        Bodies const & o = * back;
+
+        for (size_t i = 0; i < p.size(); ++ i)
+        {
+            // v = v0 + (a0 + a1)*t/2 + (j0 - j1)*t^2/12
+            add(o.vx[i], o.evx[i], ((o.ax[i] + p.ax[i]) / 2 + (o.jx[i] - p.jx[i]) * dt / 12) * dt, p.vx[i], p.evx[i]);
+            add(o.vy[i], o.evy[i], ((o.ay[i] + p.ay[i]) / 2 + (o.jy[i] - p.jy[i]) * dt / 12) * dt, p.vy[i], p.evy[i]);
+            add(o.vz[i], o.evz[i], ((o.az[i] + p.az[i]) / 2 + (o.jz[i] - p.jz[i]) * dt / 12) * dt, p.vz[i], p.evz[i]);
+
+            // p = p0 + (v0 + v1)*t/2 + (a0 - a1)*t^2/12
+            add(o.x[i], o.ex[i], ((o.vx[i] + p.vx[i]) / 2 + (o.ax[i] - p.ax[i]) * dt / 12) * dt, p.x[i], p.ex[i]);
+            add(o.y[i], o.ey[i], ((o.vy[i] + p.vy[i]) / 2 + (o.ay[i] - p.ay[i]) * dt / 12) * dt, p.y[i], p.ey[i]);
+            add(o.z[i], o.ez[i], ((o.vz[i] + p.vz[i]) / 2 + (o.az[i] - p.az[i]) * dt / 12) * dt, p.z[i], p.ez[i]);
+        }
+    }
+
+/**
+	@brief			Level of a body from its last acceleration: the coarsest one whose step is below eta * |v| / |a|
+	@param i		Index of the planet or photon
+	@param dt		Time interval of level 0
+*/
+
+template <typename R>
+    size_t BasicSimulation<R>::level(size_t i, R dt) const
+    {
+        Bodies const & f = * front;
+
+        R const a = sqrt(f.ax[i] * f.ax[i] + f.ay[i] * f.ay[i] + f.az[i] * f.az[i]);
+        R const v = sqrt(f.vx[i] * f.vx[i] + f.vy[i] * f.vy[i] + f.vz[i] * f.vz[i]);
+
+        size_t k = 0;
+
+        // bodies at rest take the finest level until they move
+        for (R h = dt; k + 1 < levels && h * a > eta * v; h /= 2)
+            ++ k;
+
+        return k;
+    }
+
+/**
+	@brief			Hierarchical kick-drift-kick: each body kicks at its own level, all of them drift together
+	@param dt		Time interval
+
+	The step is cut into 2^(levels - 1) ticks; a body of level k kicks every 2^(levels - 1 - k) ticks, and
+	only the bodies ending their step at a tick are force-evaluated there. A body moves to a finer level at
+	the end of any of its steps, and to a coarser one only where the steps of that level end too. The
+	positions are updated in place: the accelerations are written apart from them.
+*/
+
+template <typename R>
+    void BasicSimulation<R>::block(R dt)
+    {
+        Bodies & f = * front;
+        size_t const n = f.size();
+        size_t const ticks = size_t(1) << (levels - 1);
+        R const tick = dt / ticks;
+
+        auto const evaluate = [this] ()
+        {
+            prepare();
+
+            Pool::shared().run(active.size(), 64, [this] (size_t b, size_t e)
+            {
+                for (size_t k = b; k < e; ++ k)
+                    accelerate(active[k]);
+            });
+        };
+
+        if (! fresh)
+        {
+            active.resize(n);
+            std::iota(active.begin(), active.end(), 0);
+            evaluate();
+            fresh = true;
+        }
+
+        if (rung.size() != n)
+        {
+            rung.resize(n);
+
+            for (size_t i = 0; i < n; ++ i)
+                rung[i] = level(i, dt);
+        }
+
+        auto const stride = [&] (size_t k) { return ticks >> k; };
+
+        for (size_t t = 0; t < ticks; )
+        {
+            size_t next = ticks;
+
+            for (size_t i = 0; i < n; ++ i)
+            {
+                size_t const s = stride(rung[i]);
+
+                // opening half kick of the bodies starting a step
+                if (t % s == 0)
+                {
+                    R const h = s * tick / 2;
+
+                    add(f.vx[i], f.evx[i], f.ax[i] * h, f.vx[i], f.evx[i]);
+                    add(f.vy[i], f.evy[i], f.ay[i] * h, f.vy[i], f.evy[i]);
+                    add(f.vz[i], f.evz[i], f.az[i] * h, f.vz[i], f.evz[i]);
+                }
+
+                next = std::min(next, (t / s + 1) * s);
+            }
+
+            // every body drifts to the next end of a step
+            R const drift = (next - t) * tick;
+
+            for (size_t i = 0; i < n; ++ i)
+            {
+                add(f.x[i], f.ex[i], f.vx[i] * drift, f.x[i], f.ex[i]);
+                add(f.y[i], f.ey[i], f.vy[i] * drift, f.y[i], f.ey[i]);
+                add(f.z[i], f.ez[i], f.vz[i] * drift, f.z[i], f.ez[i]);
+            }
+
+            t = next;
+
+            active.clear();
+
+            for (size_t i = 0; i < n; ++ i)
+                if (t % stride(rung[i]) == 0)
+                    active.push_back(i);
+
+            evaluate();
+
+            // closing half kick & next level of the active bodies
+            for (size_t i : active)
+            {
+                R const h = stride(rung[i]) * tick / 2;
+
+                add(f.vx[i], f.evx[i], f.ax[i] * h, f.vx[i], f.evx[i]);
+                add(f.vy[i], f.evy[i], f.ay[i] * h, f.vy[i], f.evy[i]);
+                add(f.vz[i], f.evz[i], f.az[i] * h, f.vz[i], f.evz[i]);
+
+                size_t k = level(i, dt);
+
+                while (k < rung[i] && t % stride(k))
+                    ++ k;
+
+                rung[i] = k;
+            }
+        }
+
+        // every body ended its step at the last tick: all the accelerations are the ones of the positions
+        fresh = true;
+    }
+
+/**
+	@brief			s = a + x or, when compensated, s + e = a + ea + x with s the rounded sum (two-sum)
+	@param a		Value
+	@param ea		Rounding error of a
+	@param x		Increment
+*/
+
+template <typename R>
+    inline void BasicSimulation<R>::add(R a, R ea, R x, R & s, R & e) const
+    {
+        if (! compensated)
+        {
+            s = a + x;
+            return;
+        }
+
+        R const y = x + ea, t = a + y, v = t - a;
+
+        e = (a - (t - v)) + (y - v);
+        s = t;
+    }
+
+// bookkeeping of the step, then publication
+template <typename R>
+    void BasicSimulation<R>::end(R dt)
+    {
+        for (size_t i = 0; i < front->size(); ++ i)
+            planet[i].update(start[0][i], front->position(i), front->velocity(i));
+
+        if (center < front->size())
+            for (size_t i = 0; i < front->size(); ++ i)
+                if (i != center)
+                {
+                    apsis(i, dt);
+
+                    if (planet[i].eType == Scenario::LB)
+                        planet[i].asymptotes.insert(front->position(i) - front->position(center), front->velocity(i) - front->velocity(center));
+                }
+
+        ++ steps;
+        time += dt;
+
+        if (std::chrono::steady_clock::now() - published >= interval.load(std::memory_order_relaxed))
+            publish();
+    }
+
+/**
+	@brief			Logs the apsis of a body around the central one during the last step, if any
+	@param i		Index of the planet
+	@param dt		Time interval
+
+	The relative orbit over the step is the cubic Hermite interpolant of the positions & velocities
+	at both of its ends, accurate to the 4th order in dt; the apsis is where the radial velocity r.v
+	changes sign on it, found by bisection down to the precision of R.
+*/
+
+template <typename R>
+    void BasicSimulation<R>::apsis(size_t i, R dt)
+    {
+        // relative positions & velocities times dt
+        vector3 const r0 = start[0][i] - start[0][center], u0 = (start[1][i] - start[1][center]) * dt;
+        vector3 const r1 = front->position(i) - front->position(center), u1 = (front->velocity(i) - front->velocity(center)) * dt;
+
+        R const f0 = r0 * u0, f1 = r1 * u1;
+
+        // approaching then receding: perihelion; receding then approaching: aphelion
+        if (signbit(f0) == signbit(f1))
+            return;
+
+        // at the fraction s of the step
+        auto const orbit = [&] (R s, vector3 & r, vector3 & u)
+        {
+            R const s2 = s * s, s3 = s2 * s;
+
+            r = r0 * (2 * s3 - 3 * s2 + 1) + u0 * (s3 - 2 * s2 + s) + r1 * (3 * s2 - 2 * s3) + u1 * (s3 - s2);
+            u = r0 * (6 * s2 - 6 * s) + u0 * (3 * s2 - 4 * s + 1) + r1 * (6 * s - 6 * s2) + u1 * (3 * s2 - 2 * s);
+        };
+
+        R a = 0.L, b = 1.L;
+        vector3 r, u;
+
+        for (int k = 0; k < std::numeric_limits<R>::digits; ++ k)
+        {
+            R const s = (a + b) / 2;
+
+            orbit(s, r, u);
+
+            if (signbit(r * u) == signbit(f0))
+                a = s;
+            else
+                b = s;
+        }
+
+        R const s = (a + b) / 2;
+
+        orbit(s, r, u);
+
+        planet[i].apsis(typename Planet::Apsis {signbit(f0) != 0, time + s * dt, r});
+    }
+
+/**
+	@brief			Copies the current state into a frame for the GUI thread, without waiting for it
+*/
+
+template <typename R>
+    void BasicSimulation<R>::publish()
+    {
+        Frame & f = frames.back();
+        Bodies const & b = * front;
+
+        f.steps = steps;
+        f.time = ::real(time);
+
+        f.p.resize(b.size());
+        f.a.resize(b.size());
+        f.v.resize(b.size());
+        f.cycles.resize(b.size());
+        f.perihelia.resize(b.size());
+        f.perihelion.resize(b.size());
+
+        for (size_t i = 0; i < b.size(); ++ i)
+        {
+            f.p[i] = ::vector3(b.position(i));
+            f.a[i] = ::vector3(b.acceleration(i));
+            f.v[i] = ::vector3(planet[i].v[1]);
+            f.cycles[i] = planet[i].cycles;
+            f.perihelia[i] = planet[i].perihelia;
+            f.perihelion[i] = ::vector3(0.L, 0.L, 0.L);
+
+            // the last perihelion passed
+            for (auto a = planet[i].apsides.rbegin(); a != planet[i].apsides.rend(); ++ a)
+                if (a->perihelion)
+                {
+                    f.perihelion[i] = ::vector3(a->p);
+                    break;
+                }
+        }
+
+        frames.publish();
+        published = std::chrono::steady_clock::now();
+    }
+
+/**
+	@brief			Moves every planet or photon n times using the current time interval
+	@param n		Number of steps
+*/
+
+template <typename R>
+    void BasicSimulation<R>::run(size_t n)
+    {
+        for (size_t i = 0; i < n; ++ i)
+            step(dt);
+    }
+
+template <typename R>
+    BasicTwins<R>::BasicTwins(BasicSimulation<R> & newton, BasicSimulation<R> & ft)
+        : twin{& newton, & ft}
+    {
+    }
+
+/**
+	@brief			Moves both simulations once
+	@param dt		Time interval
+*/
+
+template <typename R>
+    void BasicTwins<R>::step(::real dt)
+    {
+        // the ticks of adaptive twins do not match: one after the other
+        if (twin[0]->integrator == Simulation::BLOCK || twin[1]->integrator == Simulation::BLOCK)
+        {
+            twin[0]->step(dt);
+            twin[1]->step(dt);
+            return;
+        }
+
+        twin[0]->begin();
+        twin[1]->begin();
+
+        for (size_t s = 0; s < std::max(twin[0]->stages(), twin[1]->stages()); ++ s)
+        {
+            // twins whose stage s needs the accelerations of their current positions
+            size_t n[2];
+
+            for (size_t k = 0; k < 2; ++ k)
+            {
+                n[k] = s < twin[k]->stages() && twin[k]->stale(s) ? twin[k]->front->size() : 0;
+
+                if (n[k])
+                    twin[k]->prepare();
+            }
+
+            // the bodies of the Newton twin, then the ones of the FT twin
+            Pool::shared().run(n[0] + n[1], 64, [this, & n] (size_t b, size_t e)
+            {
+                for (size_t i = b; i < e; ++ i)
+                    if (i < n[0])
+                        twin[0]->accelerate(i);
+                    else
+                        twin[1]->accelerate(i - n[0]);
+            });
+
+            for (size_t k = 0; k < 2; ++ k)
+            {
+                if (n[k])
+                    twin[k]->fresh = true;
+
+                if (s < twin[k]->stages())
+                    twin[k]->stage(s, dt);
+            }
+        }
+
+        twin[0]->end(dt);
+        twin[1]->end(dt);
+    }
+
+/**
+	@brief			Moves both simulations n times using the time interval of the Newton twin
+	@param n		Number of steps
+*/
+
+template <typename R>
+    void BasicTwins<R>::run(size_t n)
+    {
+        for (size_t i = 0; i < n; ++ i)
+            step(twin[0]->dt);
+    }
+
+template struct BasicPlanet<::real>;
+template struct BasicPlanet<DoubleDouble>;
+template struct BasicPlanet<Quad>;
+
+template struct BasicBodies<::real>;
+template struct BasicBodies<DoubleDouble>;
+template struct BasicBodies<Quad>;
+
+template class BasicSimulation<::real>;
+template class BasicSimulation<DoubleDouble>;
+template class BasicSimulation<Quad>;
+
+template class BasicTwins<::real>;
+template class BasicTwins<DoubleDouble>;
+template class BasicTwins<Quad>;
@@ -0,0 +1,524 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cmath>
+#include <atomic>
+#include <limits>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#define BOOST_DISABLE_ASSERTS
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/align/aligned_allocator.hpp>
+
+#include "forcelaw.h"
+#include "triplebuffer.h"
+
+constexpr real c = 299792458.L;
+constexpr real G = 6.67428e-11L;
+constexpr real K = 8.987551e9L;
+constexpr real K_m = 1e-7L;
+constexpr real Eta = 1e-3; //0.0013342L;
+constexpr real Q = 1.602176634e-19L;
+constexpr real Q_m = 3.291e-9L; // C*m/s
+constexpr real H[] = {c*c/(G), 0., 1e20L};
+constexpr real a = 5.29e-11L;
+constexpr real r_0 = 1e-15L;
+
+// colors as 0xAARRGGBB, same values as the Qt::GlobalColor they replace
+namespace color
+{
+    constexpr unsigned black = 0xff000000;
+    constexpr unsigned red = 0xffff0000;
+    constexpr unsigned green = 0xff00ff00;
+    constexpr unsigned blue = 0xff0000ff;
+    constexpr unsigned cyan = 0xff00ffff;
+    constexpr unsigned magenta = 0xffff00ff;
+    constexpr unsigned yellow = 0xffffff00;
+    constexpr unsigned darkRed = 0xff800000;
+    constexpr unsigned darkGreen = 0xff008000;
+    constexpr unsigned darkBlue = 0xff000080;
+    constexpr unsigned darkGray = 0xff808080;
+}
+
+/**
+	@brief			3D vector of the scalar R
+*/
+
+template <typename R>
+struct basic_vector3
+{
+    typedef R T;
+	static const size_t N = 3;
+
+	T elem_[N];
+
+	basic_vector3()
+	{
+	}
+
+	basic_vector3(const basic_vector3 &) = default;
+
+	basic_vector3(const T & b1, const T & b2, const T & b3)
+	{
+		elem_[0] = b1;
+		elem_[1] = b2;
+		elem_[2] = b3;
+	}
+
+    // same vector with another scalar
+    template <typename U>
+        explicit basic_vector3(const basic_vector3<U> & b)
+        {
+            for (size_t i = 0; i < N; ++ i)
+                elem_[i] = T(b[i]);
+        }
+
+    basic_vector3 & operator = (const basic_vector3 & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] = b.elem_[i];
+
+        return * this;
+	}
+
+	T & operator [] (const size_t n)
+	{
+		return elem_[n];
+	}
+
+	const T & operator [] (const size_t n) const
+	{
+		return elem_[n];
+	}
+
+	T norm () const
+	{
+		T nnorm2 = 0.L;
+
+		for (size_t i = 0; i < N; ++ i)
+			nnorm2 += elem_[i] * elem_[i];
+
+		return sqrt(nnorm2);
+	}
+
+	basic_vector3 cross(const basic_vector3 & b) const
+	{
+		basic_vector3 result;
+
+		result[0] = elem_[1]*b.elem_[2] - elem_[2]*b.elem_[1];
+		result[1] = elem_[2]*b.elem_[0] - elem_[0]*b.elem_[2];
+		result[2] = elem_[0]*b.elem_[1] - elem_[1]*b.elem_[0];
+
+		return result;
+	}
+
+	basic_vector3 operator - () const
+	{
+		basic_vector3 result;
+
+		for (size_t i = 0; i < N; ++ i)
+			result[i] = - elem_[i];
+
+		return result;
+	}
+
+	T operator * (const basic_vector3 & b) const
+	{
+		T ndot = 0.L;
+
+		for (size_t i = 0; i < N; ++ i)
+			ndot += elem_[i] * b.elem_[i];
+
+		return ndot;
+	}
+
+	basic_vector3 operator * (const T & b) const
+	{
+		basic_vector3 result;
+
+		for (size_t i = 0; i < N; ++ i)
+			result[i] = elem_[i] * b;
+
+		return result;
+	}
+
+	basic_vector3 operator / (const T & b) const
+	{
+		basic_vector3 result;
+
+		for (size_t i = 0; i < N; ++ i)
+			result[i] = elem_[i] / b;
+
+		return result;
+	}
+
+	basic_vector3 operator + (const basic_vector3 & b) const
+	{
+		basic_vector3 result;
+
+		for (size_t i = 0; i < N; ++ i)
+			result[i] = elem_[i] + b.elem_[i];
+
+		return result;
+	}
+
+	basic_vector3 operator - (const basic_vector3 & b) const
+	{
+		basic_vector3 result;
+
+		for (size_t i = 0; i < N; ++ i)
+			result[i] = elem_[i] - b.elem_[i];
+
+		return result;
+	}
+
+	void operator += (const basic_vector3 & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] += b.elem_[i];
+	}
+
+	void operator -= (const basic_vector3 & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] -= b.elem_[i];
+	}
+
+	void operator *= (const basic_vector3 & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] *= b.elem_[i];
+	}
+
+	void operator /= (const basic_vector3 & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] /= b.elem_[i];
+	}
+
+	void operator += (const T & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] += b;
+	}
+
+	void operator -= (const T & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] -= b;
+	}
+
+	void operator *= (const T & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] *= b;
+	}
+
+	void operator /= (const T & b)
+	{
+		for (size_t i = 0; i < N; ++ i)
+			elem_[i] /= b;
+	}
+};
+
+typedef basic_vector3<real> vector3;
+
+// scenarios
+struct Scenario
+{
+    enum Type {PP, LB, BB, GR, V1, NU, QU, CO};         // is for the perihelion precession disparity or the gravitational light bending
+};
+
+/**
+	@brief			Bookkeeping of a planet or photon, in the scalar R of its simulation
+*/
+
+template <typename R>
+struct BasicPlanet : Scenario
+{
+    typedef basic_vector3<R> vector3;
+
+    // closest or farthest point of the orbit around the central body (see Simulation::center)
+    struct Apsis
+    {
+        bool perihelion;                    // or aphelion
+        R time;                             // simulated time
+        vector3 p;                          // position relative to the central body
+    };
+
+    // incoming & outgoing directions of motion, fitted far from the central body (see Asymptotes::insert)
+    struct Asymptotes
+    {
+        R s[2][5] = {};                     // incoming & outgoing sums of x^k
+        R t[2][3][3] = {};                  // sums of x^k times each component of the direction
+
+        void insert(const vector3 & r, const vector3 & v);
+        vector3 direction(size_t k) const;
+        real deflection() const;
+    };
+
+    static inline size_t counter = 0;
+
+    char const * n;						// name
+    size_t id = counter ++;             // id
+    unsigned c;							// color (0xAARRGGBB)
+	R m;								// mass
+    R q;                                // charge
+	vector3 p;							// initial position (then see Simulation::body)
+    vector3 v[2];						// initial & saved velocity
+    vector3 o;							// old position
+    bool first;                         // first cycle
+	size_t cycles = 0;					// completed cycles of the planet or crossings of the photon arrival line
+    std::vector<Apsis> apsides;         // log of the apsides passed, in time order
+    size_t perihelia = 0;               // of the apsides
+    Asymptotes asymptotes;              // LB: of the path of the photon around the central body
+    vector3 pp[2];						// current & old saved positions on the perihelion
+    vector3 ps[5];						// current & old polar coordinates of pp
+    Law law;                            // Newton or FT time & acceleration formulas
+    R hg, he;                           // fudge factor
+    Type eType;                         // scenario
+    bool test;                          // test particle: feels the forces of the others, exerts none
+
+    BasicPlanet(char const * n, unsigned c, real m, real q, const real pp[3], const real pv[3], Law law, Type eType, real hg, real he, bool test = false)
+        : n(n), c(c), m(m), q(q), p(pp[0], pp[1], pp[2]), first(true), law(law), eType(eType), hg(hg), he(he), test(test)
+	{
+        v[0] = vector3(pv[0], pv[1], pv[2]);
+	}
+
+	void update(const vector3 & s, const vector3 & p, const vector3 & v);
+    void apsis(const Apsis & a);
+    real precession() const;
+};
+
+/**
+	@brief			Structure-of-arrays copy of what the force loop reads & writes, one entry per planet
+*/
+
+template <typename R>
+struct BasicBodies
+{
+    typedef basic_vector3<R> vector3;
+
+    template <typename T>
+        using array = std::vector<T, boost::alignment::aligned_allocator<T, 64>>;
+
+    array<R> x, y, z;                       // position
+    array<R> vx, vy, vz;                    // velocity
+    array<R> m, q;                          // mass & charge
+    array<R> ax, ay, az;                    // net acceleration
+    array<R> tg, te;                        // gravitational & electric time dilation increments
+    array<R> jx, jy, jz;                    // jerk (HERMITE only)
+    array<R> ex, ey, ez;                    // rounding error of the position (compensated only)
+    array<R> evx, evy, evz;                 // rounding error of the velocity (compensated only)
+
+    size_t size() const
+    {
+        return x.size();
+    }
+
+    vector3 position(size_t i) const
+    {
+        return vector3(x[i], y[i], z[i]);
+    }
+
+    vector3 velocity(size_t i) const
+    {
+        return vector3(vx[i], vy[i], vz[i]);
+    }
+
+    vector3 acceleration(size_t i) const
+    {
+        return vector3(ax[i], ay[i], az[i]);
+    }
+
+    void push_back(const vector3 & p, const vector3 & v, R m, R q);
+};
+
+template <typename R>
+    class BasicTree;
+
+namespace kernel
+{
+    template <typename R>
+        struct Sum;
+
+    template <typename R>
+        using Function = Sum<R> (*)(const BasicBodies<R> & body, size_t i, size_t b, size_t e, R hg, R he);
+}
+
+/**
+	@brief			What the GUI thread reads of a simulation, published by its stepping thread
+*/
+
+struct Frame
+{
+    size_t steps = 0;                       // Simulation::steps
+    real time = 0.L;                        // Simulation::time
+    std::vector<vector3> p, a;              // position & acceleration of each planet
+    std::vector<vector3> v;                 // Planet::v[1]
+    std::vector<size_t> cycles;             // Planet::cycles
+    std::vector<size_t> perihelia;          // Planet::perihelia
+    std::vector<vector3> perihelion;        // position of the last one relative to the central body, or 0
+};
+
+/**
+	@brief			Numerical methods of the simulations, whatever their scalar
+*/
+
+struct Numerics
+{
+    // direct summation, or Barnes-Hut tree
+    enum Solver {DIRECT, TREE};
+
+    // first order (v += a*t, then p += v*t + a*t^2/2), symplectic compositions of kicks & drifts,
+    // leapfrog of each body at its own power of 2 fraction of the step, or 4th order Hermite
+    enum Integrator {EULER, LEAPFROG, YOSHIDA4, YOSHIDA6, FOREST_RUTH, BLOCK, HERMITE};
+
+    static constexpr size_t none = size_t(-1);
+
+    static real defaultTime(Scenario::Type eType);
+    static Solver defaultSolver(Scenario::Type eType);
+    static Integrator defaultIntegrator(Scenario::Type eType);
+    static size_t defaultCenter(Scenario::Type eType);
+};
+
+/**
+	@brief			Owns the bodies of one scenario and advances them, independently of any widget
+
+	The state, the force laws, the integrators & the tree compute in the scalar R: real (double,
+	with the vectorized kernels), DoubleDouble or Quad (scalar kernel). What is published to other
+	threads is converted to real.
+
+	When compensated, each position & velocity is the sum of the value & of its rounding error,
+	which the integrators carry from one update to the next; the kernels compute the pair forces
+	in R from these positions and sum them with Neumaier's compensation (DIRECT solver only: the
+	tree walks the plain positions).
+
+	The test particles (Planet::test) are kept after the other bodies, which alone are summed by the
+	force loop: n sources & m test particles cost O((n + m) n) instead of O((n + m)^2). They move
+	with the others, in the same arrays; with the TREE solver they are summed directly.
+*/
+
+template <typename R>
+class BasicSimulation : public Numerics
+{
+public:
+    typedef basic_vector3<R> vector3;
+    typedef BasicPlanet<R> Planet;
+    typedef BasicBodies<R> Bodies;
+    typedef BasicTree<R> Tree;
+
+    BasicSimulation(Scenario::Type eType, size_t t);
+    ~BasicSimulation();
+
+    void step(real dt);
+    void run(size_t n);
+    void insert(const Planet & p);
+
+    Scenario::Type const eType;             // scenario
+    size_t const t;                         // 0: Newton, 1: Finite Theory
+
+    std::atomic<real> dt;                   // time interval used by run()
+    Solver solver;                          // how the accelerations are summed
+    Integrator integrator;                  // how they move the bodies
+    real eta = 0.01L;                       // BLOCK: step of a body below eta * |v| / |a|
+    size_t levels = 8;                      // BLOCK: steps of a body from dt down to dt / 2^(levels - 1)
+    bool compensated = false;               // positions & velocities carried with their rounding errors, compensated force sums
+    size_t center;                          // body the apsides of the others are found around, or none
+    size_t sources = 0;                     // bodies [0, sources) act on all the others; the test particles follow them
+    size_t steps = 0;                       // number of steps taken
+    R time = 0.L;                           // simulated time
+
+    std::vector<Planet> planet;             // bookkeeping of each planet (cold)
+
+    // state after the last step(), for the thread that steps
+    Bodies const & body() const
+    {
+        return * front;
+    }
+
+    // state for another thread, published every interval at most
+    TripleBuffer<Frame> frames;
+    std::atomic<std::chrono::steady_clock::duration> interval {std::chrono::milliseconds(20)};
+
+    kernel::Function<R> force[2][std::tuple_size<Laws>::value];    // pairwise kernel of each force law, plain & compensated
+    kernel::Function<R> jerk[2][std::tuple_size<Laws>::value];     // same, with the jerk
+    std::unique_ptr<Tree> const tree;       // used by the TREE solver (see Tree::theta)
+
+protected:
+    template <typename>
+        friend class BasicTwins;
+
+    void load();
+    void begin();
+    size_t stages() const;
+    bool stale(size_t s) const;
+    void prepare();
+    void accelerate(size_t i);
+    void stage(size_t s, R dt);
+    void hermite(size_t s, R dt);
+    void block(R dt);
+    size_t level(size_t i, R dt) const;
+    void end(R dt);
+    void apsis(size_t i, R dt);
+    void publish();
+    void add(R a, R ea, R x, R & s, R & e) const;
+
+    Bodies state[2];                        // state of each planet (hot), double buffered
+    Bodies * front = & state[0];            // current, read by the force loop
+    Bodies * back = & state[1];             // next, written by each stage of step()
+
+    bool fresh = false;                     // the accelerations of front are the ones of its positions
+    std::vector<vector3> start[2];          // positions & velocities before the step
+    std::vector<size_t> rung;               // BLOCK: level of each body, step dt / 2^rung
+    std::vector<size_t> active;             // BLOCK: bodies ending their step
+
+    std::chrono::steady_clock::time_point published;
+};
+
+/**
+	@brief			Newton & Finite Theory simulations of a scenario advanced in lockstep
+
+	Both always have taken the same number of steps of the same time interval, so they can be
+	compared step by step; the forces of both are evaluated in a single pass of the pool.
+*/
+
+template <typename R>
+class BasicTwins
+{
+public:
+    BasicTwins(BasicSimulation<R> & newton, BasicSimulation<R> & ft);
+
+    void step(real dt);
+    void run(size_t n);
+
+    BasicSimulation<R> * const twin[2];
+};
+
+// instantiated for these scalars only (see simulation.cpp)
+typedef BasicPlanet<real> Planet;
+typedef BasicBodies<real> Bodies;
+typedef BasicSimulation<real> Simulation;
+typedef BasicTwins<real> Twins;
+
+#endif
@@ -0,0 +1,187 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <queue>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+/**
+	@brief			Exact running median of a stream, duplicates included
+
+	The lower half of the samples is kept in a max-heap and the upper half in a min-heap, the
+	lower one holding the middle sample of an odd count: insert() is O(log n), median() O(1).
+*/
+
+template <typename T>
+    class Median
+    {
+    public:
+        void insert(const T & x)
+        {
+            if (lower.empty() || x <= lower.top())
+                lower.push(x);
+            else
+                upper.push(x);
+
+            // as many samples in each half, or one more in the lower one
+            if (lower.size() > upper.size() + 1)
+            {
+                upper.push(lower.top());
+                lower.pop();
+            }
+            else if (upper.size() > lower.size())
+            {
+                lower.push(upper.top());
+                upper.pop();
+            }
+        }
+
+        size_t size() const
+        {
+            return lower.size() + upper.size();
+        }
+
+        // mean of the 2 middle samples of an even count
+        T median() const
+        {
+            return lower.size() > upper.size() ? lower.top() : (lower.top() + upper.top()) / 2;
+        }
+
+    protected:
+        std::priority_queue<T> lower;
+        std::priority_queue<T, std::vector<T>, std::greater<T>> upper;
+    };
+
+/**
+	@brief			P-square estimate of the p-quantile of a stream (Jain & Chlamtac, 1985)
+
+	5 markers track the minimum, the p/2, p & (1 + p)/2 quantiles and the maximum; the middle ones
+	move by piecewise parabolic interpolation as the samples come. Memory & time per sample are
+	constant; the estimate is exact up to 5 samples.
+*/
+
+template <typename T>
+    class Quantile
+    {
+    public:
+        explicit Quantile(double p = .5)
+            : increment{0., p / 2, p, (1. + p) / 2, 1.}, p(p)
+        {
+        }
+
+        void insert(const T & x)
+        {
+            if (n < 5)
+            {
+                q[n ++] = x;
+                std::sort(q, q + n);
+
+                for (size_t i = 0; i < 5; ++ i)
+                {
+                    position[i] = double(i + 1);
+                    desired[i] = 1. + 4. * increment[i];
+                }
+
+                return;
+            }
+
+            ++ n;
+
+            // cell [q[k], q[k + 1]) of x, the extreme markers following the extreme samples
+            size_t k = 0;
+
+            if (x < q[0])
+                q[0] = x;
+            else if (x >= q[4])
+            {
+                q[4] = x;
+                k = 3;
+            }
+            else
+                while (x >= q[k + 1])
+                    ++ k;
+
+            for (size_t i = k + 1; i < 5; ++ i)
+                position[i] += 1.;
+
+            for (size_t i = 0; i < 5; ++ i)
+                desired[i] += increment[i];
+
+            // middle markers more than one position away from where they should be
+            for (size_t i = 1; i < 4; ++ i)
+            {
+                double const d = desired[i] - position[i];
+
+                if ((d >= 1. && position[i + 1] - position[i] > 1.) || (d <= -1. && position[i - 1] - position[i] < -1.))
+                {
+                    int const s = d > 0. ? 1 : -1;
+                    T const h = parabolic(i, s);
+
+                    q[i] = q[i - 1] < h && h < q[i + 1] ? h : linear(i, s);
+                    position[i] += s;
+                }
+            }
+        }
+
+        size_t size() const
+        {
+            return n;
+        }
+
+        // interpolated between the sorted samples while there are less than 5
+        T value() const
+        {
+            if (n >= 5)
+                return q[2];
+
+            if (n == 0)
+                return T(0);
+
+            double const r = p * (n - 1);
+            size_t const k = size_t(r);
+
+            return k + 1 < n ? q[k] + (q[k + 1] - q[k]) * T(r - k) : q[k];
+        }
+
+    protected:
+        T parabolic(size_t i, int s) const
+        {
+            double const l = position[i] - position[i - 1], r = position[i + 1] - position[i];
+
+            return q[i] + T(s / (l + r)) * (T((l + s) / r) * (q[i + 1] - q[i]) + T((r - s) / l) * (q[i] - q[i - 1]));
+        }
+
+        T linear(size_t i, int s) const
+        {
+            return q[i] + (q[i + s] - q[i]) / T(position[i + s] - position[i]) * T(s);
+        }
+
+        T q[5];                             // heights of the markers (the samples while n < 5)
+        double position[5];                 // actual positions of the markers
+        double desired[5];                  // desired positions
+        double const increment[5];          // of the desired positions per sample
+        double const p;
+        size_t n = 0;                       // samples
+    };
+
+#endif
@@ -0,0 +1,101 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRAIL_H
+#define TRAIL_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/**
+	@brief			Recent path of each body, in a ring of a fixed number of points per body
+
+	A position only enters the ring once it is far enough from the last one kept: how long a trail
+	lasts depends on the spacing asked for, its memory does not. All the rings are allocated once
+	by resize(); the oldest points are overwritten.
+*/
+
+template <typename T>
+    class Trails
+    {
+    public:
+        explicit Trails(size_t capacity = 1024)
+            : capacity(capacity)
+        {
+        }
+
+        void resize(size_t bodies)
+        {
+            point.assign(bodies * capacity, Point());
+            head.assign(bodies, 0);
+            count.assign(bodies, 0);
+        }
+
+        size_t bodies() const
+        {
+            return head.size();
+        }
+
+        void clear()
+        {
+            std::fill(count.begin(), count.end(), 0);
+        }
+
+        // keeps (x, y) if it is at least spacing away from the last point of body i
+        void insert(size_t i, T x, T y, T spacing)
+        {
+            if (count[i])
+            {
+                Point const & l = at(i, count[i] - 1);
+
+                if ((x - l.x) * (x - l.x) + (y - l.y) * (y - l.y) < spacing * spacing)
+                    return;
+            }
+
+            point[i * capacity + head[i]] = Point {x, y};
+            head[i] = (head[i] + 1) % capacity;
+
+            if (count[i] < capacity)
+                ++ count[i];
+        }
+
+        size_t size(size_t i) const
+        {
+            return count[i];
+        }
+
+        struct Point
+        {
+            T x, y;
+        };
+
+        // k-th point of body i, the oldest first
+        Point const & at(size_t i, size_t k) const
+        {
+            return point[i * capacity + (head[i] + capacity - count[i] + k) % capacity];
+        }
+
+    protected:
+        size_t const capacity;              // points per body
+        std::vector<Point> point;           // ring of body i at [i * capacity, (i + 1) * capacity)
+        std::vector<size_t> head;           // next point written in each ring
+        std::vector<size_t> count;          // points kept in each ring
+    };
+
+#endif
@@ -0,0 +1,370 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tree.h"
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+using namespace std;
+
+template <typename R>
+    BasicTree<R>::BasicTree()
+    {
+        for (size_t l = 0; l < std::tuple_size<Laws>::value; ++ l)
+            direct[l] = kernel::select<R>(Law(l));
+    }
+
+/**
+	@brief			Sorts the bodies into cells & sums the moments of each cell
+	@param source	Bodies of the simulation
+	@param n		Bodies [0, n) of source to sort: the ones acting on the others
+*/
+
+template <typename R>
+    void BasicTree<R>::build(const Bodies & source, size_t n)
+    {
+        index.resize(n);
+        rank.resize(n);
+        scratch.resize(n);
+        cell.clear();
+
+        iota(index.begin(), index.end(), 0);
+
+        // root: cube around all the bodies
+        R lo[3] = {0.L, 0.L, 0.L}, hi[3] = {0.L, 0.L, 0.L};
+
+        if (n)
+        {
+            lo[0] = hi[0] = source.x[0];
+            lo[1] = hi[1] = source.y[0];
+            lo[2] = hi[2] = source.z[0];
+        }
+
+        for (size_t i = 1; i < n; ++ i)
+        {
+            R const p[3] = {source.x[i], source.y[i], source.z[i]};
+
+            for (size_t k = 0; k < 3; ++ k)
+            {
+                lo[k] = min(lo[k], p[k]);
+                hi[k] = max(hi[k], p[k]);
+            }
+        }
+
+        Cell root;
+
+        for (size_t k = 0; k < 3; ++ k)
+            root.c[k] = (lo[k] + hi[k]) / 2;
+
+        root.l = max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]}) / 2;
+        root.b = 0;
+        root.e = n;
+
+        cell.push_back(root);
+        split(source, 0, 0);
+
+        // copy of what the kernels read, in cell order
+        for (auto * a : {& body.x, & body.y, & body.z, & body.vx, & body.vy, & body.vz, & body.m, & body.q})
+            a->resize(n);
+
+        for (size_t k = 0; k < n; ++ k)
+        {
+            size_t const i = index[k];
+
+            body.x[k] = source.x[i];
+            body.y[k] = source.y[i];
+            body.z[k] = source.z[i];
+            body.vx[k] = source.vx[i];
+            body.vy[k] = source.vy[i];
+            body.vz[k] = source.vz[i];
+            body.m[k] = source.m[i];
+            body.q[k] = source.q[i];
+
+            rank[i] = k;
+        }
+
+        gather(0);
+    }
+
+/**
+	@brief			Splits a cell into its non-empty octants, recursively
+	@param source	Bodies of the simulation
+	@param k		Cell
+	@param level	Depth of the cell
+*/
+
+template <typename R>
+    void BasicTree<R>::split(const Bodies & source, size_t k, size_t level)
+    {
+        size_t const b = cell[k].b, e = cell[k].e;
+
+        cell[k].child = 0;
+        cell[k].children = 0;
+
+        if (e - b <= leaf || level == depth)
+            return;
+
+        R const c[3] = {cell[k].c[0], cell[k].c[1], cell[k].c[2]}, l = cell[k].l / 2;
+
+        auto const octant = [&](size_t i)
+        {
+            return size_t(source.x[i] >= c[0]) | size_t(source.y[i] >= c[1]) << 1 | size_t(source.z[i] >= c[2]) << 2;
+        };
+
+        // counting sort of [b, e) by octant
+        size_t first[9] = {};
+
+        for (size_t j = b; j < e; ++ j)
+            ++ first[octant(index[j]) + 1];
+
+        for (size_t o = 0; o < 8; ++ o)
+            first[o + 1] += first[o];
+
+        size_t next[8];
+
+        copy(first, first + 8, next);
+
+        for (size_t j = b; j < e; ++ j)
+            scratch[b + next[octant(index[j])] ++] = index[j];
+
+        copy(scratch.begin() + b, scratch.begin() + e, index.begin() + b);
+
+        // children are contiguous
+        cell[k].child = cell.size();
+
+        for (size_t o = 0; o < 8; ++ o)
+            if (first[o] < first[o + 1])
+            {
+                Cell child;
+
+                child.c[0] = c[0] + (o & 1 ? l : - l);
+                child.c[1] = c[1] + (o & 2 ? l : - l);
+                child.c[2] = c[2] + (o & 4 ? l : - l);
+                child.l = l;
+                child.b = b + first[o];
+                child.e = b + first[o + 1];
+
+                cell.push_back(child);
+                ++ cell[k].children;
+            }
+
+        for (size_t j = cell[k].child, n = cell[k].children; n; ++ j, -- n)
+            split(source, j, level + 1);
+    }
+
+/**
+	@brief			Sums the clusters of a cell from its bodies or its children, recursively
+	@param k		Cell
+*/
+
+template <typename R>
+    void BasicTree<R>::gather(size_t k)
+    {
+        Cell & n = cell[k];
+
+        Cluster * const o[] = {& n.m[0], & n.m[1], & n.q[0], & n.q[1]};
+
+        R w[4][3] = {};                    // positions weighted by the masses or charges
+
+        for (Cluster * g : o)
+        {
+            fill(g->s, g->s + moments, 0.L);
+            g->max = 0.L;
+        }
+
+        if (n.children == 0)
+            for (size_t j = n.b; j < n.e; ++ j)
+            {
+                R const x[] = {body.x[j], body.y[j], body.z[j]};
+                R const v[] = {body.m[j], body.q[j]};
+
+                for (size_t l = 0; l < 2; ++ l)
+                {
+                    size_t const g = 2 * l + signbit(v[l]);
+
+                    for (size_t d = 0; d < 3; ++ d)
+                        w[g][d] += v[l] * x[d];
+
+                    R t = v[l];
+
+                    for (size_t e = 0; e < moments; ++ e, t *= v[l])
+                        o[g]->s[e] += t;
+
+                    o[g]->max = max(o[g]->max, abs(v[l]));
+                }
+            }
+        else
+            for (size_t j = n.child; j < n.child + n.children; ++ j)
+            {
+                gather(j);
+
+                Cell const & child = cell[j];
+
+                Cluster const * const h[] = {& child.m[0], & child.m[1], & child.q[0], & child.q[1]};
+
+                for (size_t l = 0; l < 4; ++ l)
+                {
+                    for (size_t d = 0; d < 3; ++ d)
+                        w[l][d] += h[l]->s[0] * h[l]->p[d];
+
+                    for (size_t e = 0; e < moments; ++ e)
+                        o[l]->s[e] += h[l]->s[e];
+
+                    o[l]->max = max(o[l]->max, h[l]->max);
+                }
+            }
+
+        // centers, or the one of the cube for empty clusters
+        for (size_t l = 0; l < 4; ++ l)
+            for (size_t d = 0; d < 3; ++ d)
+                o[l]->p[d] = o[l]->s[0] != 0.L ? w[l][d] / o[l]->s[0] : n.c[d];
+    }
+
+/**
+	@brief			Net acceleration of a body: pairwise in the nearby leaves, by cluster elsewhere
+	@param direct	Kernel of the force law L
+	@param i		Index of the body in the simulation
+*/
+
+template <typename R>
+    template <class L>
+        kernel::Sum<R> BasicTree<R>::walk(kernel::Function<R> direct, size_t i, R hg, R he) const
+        {
+            size_t const r = rank[i];
+
+            R const x[3] = {body.x[r], body.y[r], body.z[r]};
+            R const v[3] = {body.vx[r], body.vy[r], body.vz[r]};
+            R const qi = body.q[r];
+
+            kernel::Sum<R> sum {};
+
+            size_t stack[7 * depth + 1], top = 0;
+
+            stack[top ++] = 0;
+
+            while (top)
+            {
+                Cell const & n = cell[stack[-- top]];
+
+                // positive & negative masses, positive & negative charges
+                Cluster const * const h[] = {& n.m[0], & n.m[1], & n.q[0], & n.q[1]};
+
+                R normal[4][3], dnorm[4], f[4];
+                bool far = r < n.b || r >= n.e;
+
+                for (size_t l = 0; l < 4 && far; ++ l)
+                {
+                    if (h[l]->s[0] == 0.L)
+                        continue;
+
+                    // vector and norm between the moving entity and the cluster
+                    for (size_t d = 0; d < 3; ++ d)
+                        normal[l][d] = x[d] - h[l]->p[d];
+
+                    R const norm = sqrt(normal[l][0] * normal[l][0] + normal[l][1] * normal[l][1] + normal[l][2] * normal[l][2]);
+
+                    far = 2 * n.l < theta * norm;
+
+                    if (far)
+                    {
+                        // quantized energy level
+                        R const e = round(sqrt(norm / 1e-15));
+
+                        dnorm[l] = 1e-15 * e * e;
+                        far = l < 2 ? L::template cluster<R>(G, h[l]->s, h[l]->max, dnorm[l], hg, f[l]) : L::template cluster<R>(K, h[l]->s, h[l]->max, dnorm[l], he, f[l]);
+                    }
+                }
+
+                if (! far)
+                {
+                    if (n.children == 0)
+                    {
+                        kernel::Sum<R> const s = direct(body, r, n.b, n.e, hg, he);
+
+                        for (size_t k = 0; k < 3; ++ k)
+                            sum.a[k] += s.a[k];
+
+                        sum.tg += s.tg;
+                        sum.te += s.te;
+                    }
+                    else
+                        for (size_t j = n.child; j < n.child + n.children; ++ j)
+                            stack[top ++] = j;
+
+                    continue;
+                }
+
+                for (size_t l = 0; l < 4; ++ l)
+                {
+                    if (h[l]->s[0] == 0.L)
+                        continue;
+
+                    // gravitational or electric, attraction or repulsion of the charges
+                    bool const electric = l >= 2;
+                    R const fl = electric ? abs(f[l]) / sqrt(K / G) : abs(f[l]);
+                    ::real const sign = ! electric || signbit(qi * (l == 2 ? 1.L : -1.L)) ? 1.L : -1.L;
+
+                    for (size_t k = 0; k < 3; ++ k)
+                    {
+                        R const u = normal[l][k] / dnorm[l];
+                        R const w = v[k] / (::c * ::c) * normal[l][k] / dnorm[l];
+
+                        sum.a[k] -= fl * u * sign + fl * w;
+                    }
+
+                    if (L::dilation)
+                    {
+                        if (electric)
+                            sum.te += L::template time<Arithmetic<R>>(h[l]->s[0], dnorm[l], he);
+                        else
+                            sum.tg += L::template time<Arithmetic<R>>(h[l]->s[0], dnorm[l], hg);
+                    }
+                }
+            }
+
+            return sum;
+        }
+
+template <typename R>
+    template <size_t... I>
+        kernel::Sum<R> BasicTree<R>::force(Law law, size_t i, R hg, R he, std::index_sequence<I...>) const
+        {
+            typedef kernel::Sum<R> (BasicTree::* Walk)(kernel::Function<R>, size_t, R, R) const;
+
+            static Walk const table[] = {& BasicTree::template walk<typename std::tuple_element<I, Laws>::type>...};
+
+            return (this->*table[law])(direct[law], i, hg, he);
+        }
+
+/**
+	@brief			Net acceleration & time dilation increments of a body, from the last build()
+	@param law		Force law of the body
+	@param i		Index of the body in the simulation
+*/
+
+template <typename R>
+    kernel::Sum<R> BasicTree<R>::force(Law law, size_t i, R hg, R he) const
+    {
+        return force(law, i, hg, he, std::make_index_sequence<std::tuple_size<Laws>::value>());
+    }
+
+template class BasicTree<::real>;
+template class BasicTree<DoubleDouble>;
+template class BasicTree<Quad>;
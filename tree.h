@@ -0,0 +1,87 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TREE_H
+#define TREE_H
+
+#include "kernel.h"
+
+/**
+	@brief			Barnes-Hut octree: the bodies of a distant cell act as one body at their center of mass
+
+	Cells seen under an angle below theta are summed through Law::cluster(), the others are opened;
+	leaves are summed pairwise with the kernels over a copy of the bodies sorted by cell. Masses and
+	charges of each sign are clustered apart, at their own center, so that the signed electric terms
+	attract or repel like the pairwise ones.
+*/
+
+template <typename R>
+class BasicTree
+{
+public:
+    typedef BasicBodies<R> Bodies;
+
+    static constexpr size_t leaf = 16;      // most bodies of a leaf
+    static constexpr size_t depth = 32;     // deepest cell (bodies at the same position)
+
+    // bodies of a cell whose masses (or charges) have the same sign
+    struct Cluster
+    {
+        R p[3];                             // center of mass (or of charge)
+        R s[moments];                       // sum m, sum m^2, ...
+        R max;                              // largest abs(m)
+    };
+
+    struct Cell
+    {
+        R c[3];                             // center of the cube
+        R l;                                // half side of the cube
+        Cluster m[2], q[2];                 // positive & negative masses and charges
+        size_t b, e;                        // bodies [b, e) of the sorted copy
+        size_t child, children;             // first child cell & number of children (0: leaf)
+    };
+
+    BasicTree();
+
+    void build(const Bodies & body, size_t n);
+    kernel::Sum<R> force(Law law, size_t i, R hg, R he) const;
+
+    real theta = 0.5L;                      // opening angle
+
+protected:
+    template <class L>
+        kernel::Sum<R> walk(kernel::Function<R> direct, size_t i, R hg, R he) const;
+
+    template <size_t... I>
+        kernel::Sum<R> force(Law law, size_t i, R hg, R he, std::index_sequence<I...>) const;
+
+    void split(const Bodies & source, size_t k, size_t level);
+    void gather(size_t k);
+
+    std::vector<Cell> cell;                 // cell[0] is the root
+    std::vector<size_t> index;              // original index of each sorted body
+    std::vector<size_t> rank;               // sorted index of each original body
+    std::vector<size_t> scratch;
+    Bodies body;                            // bodies sorted by cell
+
+    kernel::Function<R> direct[std::tuple_size<Laws>::value];
+};
+
+typedef BasicTree<real> Tree;
+
+#endif
@@ -0,0 +1,72 @@
+/**
+    Finite Theory Simulator
+    Copyright (C) 2011 Phil Bouchard <philippeb8@gmail.com>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+/**
+	@brief			Lock-free channel of the latest value from one producer thread to one consumer thread
+
+	The producer fills back() then publish()es it; the consumer calls update() to take the latest
+	published value, if any, and reads front(). Neither side ever waits for the other: they only
+	exchange the index of the spare buffer, intermediate values are dropped.
+*/
+
+template <typename T>
+    class TripleBuffer
+    {
+    public:
+        // producer
+        T & back()
+        {
+            return buffer[write];
+        }
+
+        void publish()
+        {
+            write = spare.exchange(write | fresh, std::memory_order_acq_rel) & index;
+        }
+
+        // consumer
+        bool update()
+        {
+            if (! (spare.load(std::memory_order_relaxed) & fresh))
+                return false;
+
+            read = spare.exchange(read, std::memory_order_acq_rel) & index;
+
+            return true;
+        }
+
+        T const & front() const
+        {
+            return buffer[read];
+        }
+
+    protected:
+        static constexpr unsigned index = 3, fresh = 4;
+
+        T buffer[3];
+        unsigned write = 0;                     // owned by the producer
+        unsigned read = 1;                      // owned by the consumer
+        std::atomic<unsigned> spare {2};        // index of the third buffer & whether it was published since
+    };
+
+#endif